@@ -0,0 +1,66 @@
+#ifndef POSICXX_ARPA_INET_HH
+#define POSICXX_ARPA_INET_HH
+#pragma once
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <cstddef>
+
+/**
+ * @brief arpa/inet.hh - file serves as CXX declarations of POSIX internet operations, containing the minimal wrapper
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/arpa/inet.h.html for general details
+ * The conversions are implemented here rather than forwarded to libc: they accept & produce exactly what glibc does, without its per-character table lookups
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief inet_ntop - convert an IPv4 or IPv6 address from binary to text form
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/inet_ntop.html for more details
+	 * IPv6 output follows glibc: lowercase hex, the first longest run of 2+ zero groups compressed, & IPv4-mapped / -compatible addresses in dotted form
+	 *
+	 * @param int af - address family, AF_INET or AF_INET6
+	 * @param const void* src - address, a struct in_addr or struct in6_addr in network byte order
+	 * @param char* dst - destination of the null-terminated text
+	 * @param socklen_t size - length of dst; INET_ADDRSTRLEN / INET6_ADDRSTRLEN always suffice
+	 *
+	 * @return const char* - dst
+	 *
+	 * @throws posicxx::Error - exception thrown upon error (EAFNOSUPPORT for another family, ENOSPC if dst is too short)
+	 */
+	const char* inet_ntop(int af, const void* src, char* dst, socklen_t size) noexcept(false) ;
+
+	/**
+	 * @brief inet_pton - convert an IPv4 or IPv6 address from text to binary form
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/inet_pton.html for more details
+	 * IPv4 takes exactly four decimal parts without leading zeros; IPv6 takes up to 4 hex digits per group, one "::" & an optional dotted IPv4 tail
+	 *
+	 * @param int af - address family, AF_INET or AF_INET6
+	 * @param const char* src - null-terminated text
+	 * @param void* dst - destination of the address, a struct in_addr or struct in6_addr; untouched if src is invalid
+	 *
+	 * @return bool - whether src was a valid address
+	 *
+	 * @throws posicxx::Error - exception thrown upon error (EAFNOSUPPORT for another family)
+	 */
+	bool inet_pton(int af, const char* src, void* dst) noexcept(false) ;
+
+	/**
+	 * @brief inet_pton (overload) - convert an IPv4 or IPv6 address from text to binary form, without needing it null-terminated
+	 * Suits addresses sliced out of a larger buffer (e.g. a log line), saving a copy & a strlen
+	 *
+	 * @param int af - address family, AF_INET or AF_INET6
+	 * @param const char* src - text
+	 * @param size_t len - length of text
+	 * @param void* dst - destination of the address, a struct in_addr or struct in6_addr; untouched if src is invalid
+	 *
+	 * @return bool - whether src was a valid address
+	 *
+	 * @throws posicxx::Error - exception thrown upon error (EAFNOSUPPORT for another family)
+	 */
+	bool inet_pton(int af, const char* src, size_t len, void* dst) noexcept(false) ;
+
+}
+
+#endif // #ifndef POSICXX_ARPA_INET_HH
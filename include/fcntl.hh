@@ -3,6 +3,11 @@
 #pragma once
 
 #include <fcntl.h>
+#include <sys/uio.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
 
 /**
  * @brief fcntl.hh - file serves as CXX declarations of POSIX file control functionality, containing the minimal wrapper
@@ -129,6 +134,416 @@ namespace posicxx {
 	 */
 	void posix_fallocate(int fd, off_t offset, off_t len) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief splice - moves data between a pipe and another file descriptor without copying through user space
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/splice.2.html for more details
+	 *
+	 * @param int fd_in - descriptor to move data from
+	 * @param off_t* off_in - offset to read from if `fd_in` isn't a pipe (NULL to use & update the file offset)
+	 * @param int fd_out - descriptor to move data into
+	 * @param off_t* off_out - offset to write to if `fd_out` isn't a pipe (NULL to use & update the file offset)
+	 * @param size_t len - maximum number of bytes to move
+	 * @param unsigned flags - 0 or any of SPLICE_F_MOVE, SPLICE_F_NONBLOCK, SPLICE_F_MORE OR'd together
+	 *
+	 * @return ssize_t - number of bytes moved. 0 means end of input
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t splice(int fd_in, off_t* off_in, int fd_out, off_t* off_out, size_t len, unsigned flags) noexcept(false) ;
+
+	/**
+	 * @brief sync_file_range - synchronises part of a file with storage, optionally without waiting
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/sync_file_range.2.html for more details
+	 * Note: this writes back data pages only - unlike posicxx::fdatasync it gives no durability guarantee for metadata
+	 *
+	 * @param int fd - open file descriptor
+	 * @param off_t offset - start of the range
+	 * @param off_t nbytes - length of the range. 0 extends the range to the end of the file
+	 * @param unsigned flags - any of SYNC_FILE_RANGE_WAIT_BEFORE, SYNC_FILE_RANGE_WRITE, SYNC_FILE_RANGE_WAIT_AFTER OR'd together
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void sync_file_range(int fd, off_t offset, off_t nbytes, unsigned flags) noexcept(false) ;
+
+	/**
+	 * @brief tee - duplicates data from one pipe into another without consuming it
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/tee.2.html for more details
+	 *
+	 * @param int fd_in - read end of the source pipe
+	 * @param int fd_out - write end of the destination pipe
+	 * @param size_t len - maximum number of bytes to duplicate
+	 * @param unsigned flags - 0 or SPLICE_F_NONBLOCK
+	 *
+	 * @return ssize_t - number of bytes duplicated
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t tee(int fd_in, int fd_out, size_t len, unsigned flags) noexcept(false) ;
+
+	/**
+	 * @brief vmsplice - maps user memory into a pipe without copying it
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/vmsplice.2.html for more details
+	 * Note: the pipe references the user pages - they mustn't be modified until the data has been consumed from the pipe
+	 *
+	 * @param int fd - write end of a pipe
+	 * @param const struct iovec* iov - segments of user memory to map
+	 * @param size_t nr_segs - number of segments
+	 * @param unsigned flags - 0 or any of SPLICE_F_GIFT, SPLICE_F_NONBLOCK OR'd together
+	 *
+	 * @return ssize_t - number of bytes mapped into the pipe
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t vmsplice(int fd, const struct iovec* iov, size_t nr_segs, unsigned flags) noexcept(false) ;
+
+#endif // #ifdef __linux__
+
+#ifdef F_OFD_SETLK
+
+	/**
+	 * @brief LockManager (class) - manages byte-range locks held on a single open file description
+	 * Uses Linux's open file description locks (F_OFD_SETLK, F_OFD_SETLKW) rather than the classic record locks behind posicxx::fcntl & posicxx::lockf
+	 * Such locks belong to the open file description, so they aren't dropped when some other descriptor to the same file is closed
+	 * Ranges which are already covered by locks this manager holds are granted from an in-process table, without a system call
+	 * Note: all threads sharing a manager share its locks - it arbitrates between open file descriptions (i.e. other processes / other opens), not between threads
+	 */
+	class LockManager {
+		public:
+			/**
+			 * @brief Stats (struct) - running counters of a manager's activity
+			 */
+			struct Stats {
+				unsigned long long syscalls ; // lock / unlock requests which had to call into the kernel
+				unsigned long long hits ; // lock requests satisfied by the in-process range table alone
+				unsigned long long contended ; // lock requests which found (part of) their range held elsewhere
+				unsigned long long waits ; // times a blocking lock request had to sleep in the kernel
+			} ;
+
+		private:
+			struct Range {
+				off_t start ; // first byte of the range
+				off_t end ; // one past the last byte of the range
+				int rank ; // 1 for a read lock, 2 for a write lock
+
+				bool operator<(const Range& other) const noexcept ;
+			} ;
+
+			int _fd ; // open file description being locked
+			std::map<Range, unsigned> _held ; // granted ranges and their number of holders
+			Stats _stats ;
+			mutable std::mutex _mutex ;
+
+			Range _range(off_t start, off_t len, short type) const noexcept(false) ;
+			std::vector<Range> _segments(off_t start, off_t end) const noexcept ;
+			bool _set(off_t start, off_t end, int rank, bool wait) noexcept(false) ;
+			bool _acquire(const Range& range, Range* contended) noexcept(false) ;
+			void _restore(off_t start, off_t end) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief LockManager (constructor) - manages locks on an open file
+			 *
+			 * @param const int fd - open file descriptor, whose open file description the locks are placed upon
+			 * The descriptor is not owned by the manager and must outlive it
+			 */
+			LockManager(const int fd) noexcept ;
+
+			/**
+			 * @brief lock - acquires a byte-range lock, blocking until it can be granted
+			 *
+			 * @param off_t start - offset of the first byte of the range
+			 * @param off_t len - number of bytes in the range. 0 extends the range to the end of the file (as with struct flock)
+			 * @param short type - F_RDLCK or F_WRLCK
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void lock(off_t start, off_t len, short type) noexcept(false) ;
+
+			/**
+			 * @brief try_lock - acquires a byte-range lock if it can be granted immediately
+			 *
+			 * @param off_t start - offset of the first byte of the range
+			 * @param off_t len - number of bytes in the range. 0 extends the range to the end of the file (as with struct flock)
+			 * @param short type - F_RDLCK or F_WRLCK
+			 *
+			 * @return bool - whether the lock was acquired
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			bool try_lock(off_t start, off_t len, short type) noexcept(false) ;
+
+			/**
+			 * @brief unlock - releases a byte-range lock previously acquired with the same arguments
+			 * The kernel lock is only released (or downgraded) over the parts of the range no other held lock still covers
+			 *
+			 * @param off_t start - offset of the first byte of the range
+			 * @param off_t len - number of bytes in the range
+			 * @param short type - F_RDLCK or F_WRLCK
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. EINVAL if no such lock is held
+			 */
+			void unlock(off_t start, off_t len, short type) noexcept(false) ;
+
+			/**
+			 * @brief stats - gets a snapshot of the manager's counters
+			 *
+			 * @return Stats - copy of counters
+			 */
+			Stats stats() const noexcept ;
+
+			/**
+			 * @brief LockManager (destructor) - releases every lock still held through the manager
+			 */
+			~LockManager() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			LockManager() noexcept = delete ;
+			LockManager(const LockManager& manager) noexcept = delete ;
+			LockManager& operator=(const LockManager& manager) noexcept = delete ;
+			LockManager(LockManager&& manager) noexcept = delete ;
+			LockManager& operator=(LockManager&& manager) noexcept = delete ;
+	} ;
+
+#endif // #ifdef F_OFD_SETLK
+
+#ifdef __linux__
+
+	/**
+	 * @brief Pipe (class) - class to create, size and close both ends of a Linux pipe
+	 * The pipe is created in one call with posicxx::pipe2, so O_CLOEXEC / O_DIRECT (packet mode) / O_NONBLOCK never race a fork
+	 * The default 64 KiB capacity can be raised up to the system maximum (/proc/sys/fs/pipe-max-size), letting the writer run further ahead of the reader before blocking
+	 */
+	class Pipe {
+		private:
+			int _fds[2] ; // read end, write end
+
+		public:
+			/**
+			 * @brief Pipe (constructor) - creates a pipe
+			 * A stub to posicxx::pipe2 - refer to it for more detail
+			 *
+			 * @param int flags - 0 or any of O_CLOEXEC, O_DIRECT, O_NONBLOCK OR'd together
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			Pipe(int flags) noexcept(false) ;
+
+			/**
+			 * @brief Pipe (constructor) - creates a pipe & grows it
+			 *
+			 * @param int flags - 0 or any of O_CLOEXEC, O_DIRECT, O_NONBLOCK OR'd together
+			 * @param size_t capacity - requested capacity in bytes. See posicxx::Pipe::resize
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			Pipe(int flags, size_t capacity) noexcept(false) ;
+
+			/**
+			 * @brief read_end - returns the descriptor of the read end
+			 *
+			 * @return int - read end of the pipe
+			 */
+			int read_end() const noexcept ;
+
+			/**
+			 * @brief write_end - returns the descriptor of the write end
+			 *
+			 * @return int - write end of the pipe
+			 */
+			int write_end() const noexcept ;
+
+			/**
+			 * @brief capacity - gets the current capacity of the pipe
+			 *
+			 * @return size_t - capacity in bytes
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t capacity() const noexcept(false) ;
+
+			/**
+			 * @brief resize - sets the capacity of the pipe (F_SETPIPE_SZ)
+			 * Requests beyond posicxx::Pipe::max_capacity are clamped to it. If per-user pipe limits refuse the size, successively halved sizes are tried, stopping at the current capacity
+			 *
+			 * @param size_t capacity - requested capacity in bytes. The kernel rounds it up to a power-of-two number of pages
+			 *
+			 * @return size_t - capacity in bytes actually set
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t resize(size_t capacity) noexcept(false) ;
+
+			/**
+			 * @brief max_capacity - gets the largest capacity an unprivileged process may give a pipe
+			 *
+			 * @return size_t - contents of /proc/sys/fs/pipe-max-size
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			static size_t max_capacity() noexcept(false) ;
+
+			/**
+			 * @brief vmsplice - maps user memory into the write end without copying it
+			 * A stub to posicxx::vmsplice - refer to it for more detail, especially regarding the lifetime of the buffers
+			 *
+			 * @param const struct iovec* iov - segments of user memory to map
+			 * @param size_t nr_segs - number of segments
+			 * @param unsigned flags - 0 or any of SPLICE_F_GIFT, SPLICE_F_NONBLOCK OR'd together
+			 *
+			 * @return ssize_t - number of bytes mapped into the pipe
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t vmsplice(const struct iovec* iov, size_t nr_segs, unsigned flags) noexcept(false) ;
+
+			/**
+			 * @brief tee - duplicates data queued in this pipe into another pipe, without consuming it
+			 * A stub to posicxx::tee - refer to it for more detail
+			 *
+			 * @param const Pipe& to - destination pipe
+			 * @param size_t len - maximum number of bytes to duplicate
+			 * @param unsigned flags - 0 or SPLICE_F_NONBLOCK
+			 *
+			 * @return ssize_t - number of bytes duplicated
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t tee(const Pipe& to, size_t len, unsigned flags) noexcept(false) ;
+
+			/**
+			 * @brief splice_to - drains data queued in this pipe into another descriptor without copying
+			 * A stub to posicxx::splice - refer to it for more detail
+			 *
+			 * @param int fd - destination descriptor
+			 * @param off_t* offset - offset to write to if `fd` isn't a pipe (NULL to use & update the file offset)
+			 * @param size_t len - maximum number of bytes to move
+			 * @param unsigned flags - 0 or any of SPLICE_F_MOVE, SPLICE_F_NONBLOCK, SPLICE_F_MORE OR'd together
+			 *
+			 * @return ssize_t - number of bytes moved
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t splice_to(int fd, off_t* offset, size_t len, unsigned flags) noexcept(false) ;
+
+			/**
+			 * @brief splice_from - fills this pipe from another descriptor without copying
+			 * A stub to posicxx::splice - refer to it for more detail
+			 *
+			 * @param int fd - source descriptor
+			 * @param off_t* offset - offset to read from if `fd` isn't a pipe (NULL to use & update the file offset)
+			 * @param size_t len - maximum number of bytes to move
+			 * @param unsigned flags - 0 or any of SPLICE_F_MOVE, SPLICE_F_NONBLOCK, SPLICE_F_MORE OR'd together
+			 *
+			 * @return ssize_t - number of bytes moved
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t splice_from(int fd, off_t* offset, size_t len, unsigned flags) noexcept(false) ;
+
+			/**
+			 * @brief Pipe (move constructor) - acquires both ends of an existing pipe
+			 *
+			 * @param Pipe&& pipe - pipe to acquire
+			 */
+			Pipe(Pipe&& pipe) noexcept ;
+
+			/**
+			 * @brief operator= (move assignment) - closes this pipe & acquires both ends of an existing pipe
+			 *
+			 * @param Pipe&& pipe - pipe to acquire
+			 *
+			 * @return Pipe& - reference to this pipe
+			 */
+			Pipe& operator=(Pipe&& pipe) noexcept ;
+
+			/**
+			 * @brief Pipe (destructor) - closes both ends of the pipe
+			 */
+			~Pipe() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			Pipe() noexcept = delete ;
+			Pipe(const Pipe& pipe) noexcept = delete ;
+			Pipe& operator=(const Pipe& pipe) noexcept = delete ;
+	} ;
+
+#endif // #ifdef __linux__
+
+	/**
+	 * @brief StreamWriter (class) - sequential writer which keeps its own footprint in the page cache bounded
+	 * Bulk writes otherwise leave every written page cached, evicting other (hotter) data. Here, each completed chunk has its write-back started straight away,
+	 * and once more than a window's worth of written data is still cached the oldest chunks are waited upon & dropped with posix_fadvise(POSIX_FADV_DONTNEED)
+	 * Write-back uses sync_file_range on Linux, so the disk is kept busy without waiting on every chunk; elsewhere each chunk falls back to posicxx::fdatasync
+	 */
+	class StreamWriter {
+		private:
+			int _fd ; // file being written, not owned
+			off_t _start ; // offset writing started at
+			off_t _offset ; // offset the next write goes to
+			off_t _flushed ; // end of the last chunk write-back was started for
+			off_t _evicted ; // end of the data dropped from the page cache
+			off_t _chunk ;
+			off_t _window ;
+
+			void _complete(bool all) noexcept(false) ;
+			void _evict(off_t end) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief StreamWriter (constructor) - starts streaming at the current file offset
+			 *
+			 * @param int fd - open file descriptor. Not owned, must outlive the writer
+			 * @param size_t chunk - bytes per chunk, the unit write-back is started for
+			 * @param size_t window - bytes of completed chunks allowed to stay in the page cache. 0 drops each chunk as soon as it's written back
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			StreamWriter(int fd, size_t chunk, size_t window) noexcept(false) ;
+
+			/**
+			 * @brief write - writes the whole of a buffer, retrying short writes
+			 * A stub to posicxx::write - refer to it for more detail
+			 *
+			 * @param const void* buf - data to write
+			 * @param size_t nbyte - number of bytes to write
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void write(const void* buf, size_t nbyte) noexcept(false) ;
+
+			/**
+			 * @brief finish - writes back & drops everything written so far, including the trailing partial chunk
+			 * The data is durable once this returns (posicxx::fdatasync)
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void finish() noexcept(false) ;
+
+			/**
+			 * @brief written - returns the number of bytes written through the writer
+			 *
+			 * @return off_t - bytes written since construction
+			 */
+			off_t written() const noexcept ;
+
+			/**
+			 * @brief cached - returns the number of written bytes which may still be in the page cache
+			 *
+			 * @return off_t - bytes written but not yet dropped
+			 */
+			off_t cached() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			StreamWriter() noexcept = delete ;
+			StreamWriter(const StreamWriter& writer) noexcept = delete ;
+			StreamWriter& operator=(const StreamWriter& writer) noexcept = delete ;
+			StreamWriter(StreamWriter&& writer) noexcept = delete ;
+			StreamWriter& operator=(StreamWriter&& writer) noexcept = delete ;
+			~StreamWriter() noexcept = default ;
+	} ;
+
 }
 
 #endif // #ifndef POSICXX_FCNTL_HH
@@ -0,0 +1,161 @@
+#ifndef POSICXX_NET_IF_HH
+#define POSICXX_NET_IF_HH
+#pragma once
+
+#include <net/if.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "netinet/in.hh"
+
+/**
+ * @brief net/if.hh - file serves as CXX declarations of POSIX network interface functionality, containing the minimal wrapper & fancy interface
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/net/if.h.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief if_indextoname - map a network interface index to its corresponding name
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/if_indextoname.html for more details
+	 *
+	 * @param unsigned ifindex - interface index
+	 * @param char* ifname - destination of the name, at least IF_NAMESIZE bytes
+	 *
+	 * @return char* - ifname
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	char* if_indextoname(unsigned ifindex, char* ifname) noexcept(false) ;
+
+	/**
+	 * @brief if_nametoindex - map a network interface name to its corresponding index
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/if_nametoindex.html for more details
+	 *
+	 * @param const char* ifname - interface name
+	 *
+	 * @return unsigned - interface index
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	unsigned if_nametoindex(const char* ifname) noexcept(false) ;
+
+#ifdef __linux__
+
+	/**
+	 * @brief InterfaceTable (class) - snapshot of the host's network interfaces, rebuilt only when rtnetlink reports a link or address change
+	 * Linux-specific. Readers on any thread get the current snapshot with a single atomic load. Snapshots are immutable & a replaced one is retired rather than freed at once: a reference stays valid for at least the grace period after its replacement, so copy out anything held longer
+	 * Changes are picked up by one thread calling refresh() when fd() is readable (e.g. from posicxx::Reactor), which also frees the retired snapshots whose grace period has passed
+	 */
+	class InterfaceTable {
+		public:
+			/**
+			 * @brief Interface (struct) - one network interface
+			 */
+			struct Interface {
+				std::string name ;
+				unsigned index ;
+				unsigned flags ; // IFF_UP, IFF_LOOPBACK, ...
+				unsigned mtu ;
+				std::vector<Endpoint> addresses ; // IPv4 & IPv6 addresses, with port 0
+			} ;
+
+			/**
+			 * @brief Snapshot (struct) - interfaces as of one refresh, ordered by index
+			 */
+			struct Snapshot {
+				std::vector<Interface> interfaces ;
+				unsigned long long generation ; // counts rebuilds, starting from 1
+
+				/**
+				 * @brief find - looks an interface up by index
+				 *
+				 * @param unsigned index - interface index
+				 *
+				 * @return const Interface* - the interface, or nullptr if there is none
+				 */
+				const Interface* find(unsigned index) const noexcept ;
+
+				/**
+				 * @brief find (overload) - looks an interface up by name
+				 *
+				 * @param const char* name - interface name
+				 *
+				 * @return const Interface* - the interface, or nullptr if there is none
+				 */
+				const Interface* find(const char* name) const noexcept ;
+			} ;
+
+		private:
+			using Clock = std::chrono::steady_clock ;
+
+			struct Retired {
+				std::unique_ptr<const Snapshot> snapshot ;
+				Clock::time_point freeable ;
+			} ;
+
+			int _netlink ;
+			Clock::duration _grace ;
+			std::atomic<const Snapshot*> _current ;
+			std::unique_ptr<const Snapshot> _owned ; // owner of _current
+			std::deque<Retired> _retired ; // oldest first
+
+			void _rebuild() noexcept(false) ;
+			void _reclaim(Clock::time_point now) noexcept ;
+
+		public:
+			/**
+			 * @brief InterfaceTable (constructor) - subscribes to rtnetlink link & address changes & builds the first snapshot
+			 *
+			 * @param unsigned grace_ms - time a replaced snapshot is kept for readers still holding it
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			explicit InterfaceTable(unsigned grace_ms = 60000) noexcept(false) ;
+
+			/**
+			 * @brief snapshot - returns the current snapshot
+			 *
+			 * @return const Snapshot& - interfaces as of the latest rebuild, valid until the grace period after it is replaced has passed
+			 */
+			const Snapshot& snapshot() const noexcept ;
+
+			/**
+			 * @brief fd - returns the nonblocking rtnetlink socket, readable when a change is pending
+			 *
+			 * @return int - netlink socket
+			 */
+			int fd() const noexcept ;
+
+			/**
+			 * @brief refresh - drains pending change notifications & rebuilds the snapshot if there were any (or the kernel's queue overflowed), then frees retired snapshots past their grace period
+			 * Only one thread may call it at a time
+			 *
+			 * @return bool - whether the snapshot was rebuilt
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			bool refresh() noexcept(false) ;
+
+			/**
+			 * @brief InterfaceTable (destructor) - closes the netlink socket & frees every snapshot
+			 */
+			~InterfaceTable() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			InterfaceTable(const InterfaceTable& table) noexcept = delete ;
+			InterfaceTable& operator=(const InterfaceTable& table) noexcept = delete ;
+			InterfaceTable(InterfaceTable&& table) noexcept = delete ;
+			InterfaceTable& operator=(InterfaceTable&& table) noexcept = delete ;
+	} ;
+
+#endif // #ifdef __linux__
+
+}
+
+#endif // #ifndef POSICXX_NET_IF_HH
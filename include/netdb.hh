@@ -0,0 +1,211 @@
+#ifndef POSICXX_NETDB_HH
+#define POSICXX_NETDB_HH
+#pragma once
+
+#include <netdb.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "netinet/in.hh"
+
+/**
+ * @brief netdb.hh - file serves as CXX declarations of POSIX network database functionality, containing the minimal wrapper & fancy interface
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/netdb.h.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief gai_category - error category of the EAI_* codes returned by getaddrinfo & reported by posicxx::Resolver, with messages from gai_strerror
+	 *
+	 * @return const std::error_category& - the category
+	 */
+	const std::error_category& gai_category() noexcept ;
+
+	/**
+	 * @brief AddrInfo - list returned by posicxx::getaddrinfo, released with freeaddrinfo
+	 */
+	using AddrInfo = std::unique_ptr<struct addrinfo, void (*)(struct addrinfo*)> ;
+
+	/**
+	 * @brief getaddrinfo - get address information
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getaddrinfo.html for more details
+	 *
+	 * @param const char* nodename - host name or numeric address, may be nullptr when servname isn't
+	 * @param const char* servname - service name or port number, may be nullptr when nodename isn't
+	 * @param const struct addrinfo* hints - preferred socket type / protocol / family, may be nullptr
+	 *
+	 * @return AddrInfo - owned list of addresses
+	 *
+	 * @throws posicxx::Error - exception thrown upon error, in posicxx::gai_category (or std::generic_category for EAI_SYSTEM)
+	 */
+	AddrInfo getaddrinfo(const char* nodename, const char* servname, const struct addrinfo* hints) noexcept(false) ;
+
+#ifdef __linux__
+
+	/**
+	 * @brief Resolver (class) - nonblocking stub resolver, speaking DNS over UDP to one nameserver, with /etc/hosts, a TTL-bounded cache & coalescing of identical lookups
+	 * Linux-specific. Meant to be driven by a single thread: register fd() for EPOLLIN (e.g. with posicxx::Reactor), call process() when it is readable & expire() when timeout() elapses
+	 * Names are looked up as given (no search domains) & case-insensitively; numeric addresses & /etc/hosts entries are answered without a query
+	 * Expired cache entries are dropped at most once a minute, from whichever of resolve(), process() & expire() runs next
+	 * Every query leaves from the one socket behind fd(), so from one source port: only the random 16-bit id (& the echoed question) guards against off-path forged answers, so use a nameserver on a trusted path, e.g. a local caching one
+ * Errors are reported in posicxx::gai_category: EAI_NONAME (no such name / no address of the family), EAI_AGAIN (timed out / server failure) & EAI_FAIL (refused / malformed / truncated without any address, as there is no fallback to TCP)
+	 */
+	class Resolver {
+		public:
+			/**
+			 * @brief Family (enum) - address family to look up, valued as the DNS record type
+			 */
+			enum class Family : uint16_t {
+				ipv4 = 1, // A
+				ipv6 = 28 // AAAA
+			} ;
+
+			/**
+			 * @brief Callback - receives the outcome of a lookup; addresses carry port 0 & are empty on error
+			 */
+			using Callback = std::function<void(const std::error_code& ec, const std::vector<Endpoint>& addresses)> ;
+
+		private:
+			using Clock = std::chrono::steady_clock ;
+
+			struct Entry {
+				std::vector<Endpoint> addresses ;
+				int error ; // EAI_* for a cached negative answer, 0 otherwise
+				Clock::time_point expiry ;
+			} ;
+
+			struct Query {
+				std::string key ;
+				uint16_t id ;
+				unsigned attempts ;
+				Clock::time_point deadline ;
+				std::vector<Callback> callbacks ;
+			} ;
+
+			int _fd ;
+			unsigned _timeout_ms ;
+			unsigned _attempts ;
+			uint64_t _rng ;
+			Clock::time_point _swept ;
+			std::unordered_map<std::string, std::vector<Endpoint>> _hosts ;
+			std::unordered_map<std::string, Entry> _cache ; // keyed by record type byte + lower-case name
+			std::unordered_map<uint16_t, Query> _queries ; // in flight, keyed by DNS id
+			std::unordered_map<std::string, uint16_t> _pending ; // key -> DNS id of the query in flight
+
+			void _connect(const Endpoint& nameserver) noexcept(false) ;
+			void _load_hosts(const char* path) noexcept(false) ;
+			void _sweep(Clock::time_point now) noexcept ;
+			void _send(const Query& query) noexcept ;
+			void _complete(uint16_t id, int error, const std::vector<Endpoint>& addresses, uint32_t ttl) noexcept(false) ;
+			bool _answer(const uint8_t* msg, size_t len) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief Resolver (constructor) - uses the first nameserver & the timeout / attempts options of /etc/resolv.conf (127.0.0.1 if none), & /etc/hosts
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			Resolver() noexcept(false) ;
+
+			/**
+			 * @brief Resolver (constructor) - uses the given nameserver, e.g. a local stub server under test
+			 *
+			 * @param const Endpoint& nameserver - address & port of the nameserver
+			 * @param const char* hosts - hosts file to consult first, or nullptr for none
+			 * @param unsigned timeout_ms - time to wait for an answer before resending
+			 * @param unsigned attempts - number of sends before failing with EAI_AGAIN
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			Resolver(const Endpoint& nameserver, const char* hosts = "/etc/hosts", unsigned timeout_ms = 5000, unsigned attempts = 2) noexcept(false) ;
+
+			/**
+			 * @brief resolve - looks the addresses of name up, invoking callback once with the outcome
+			 * Answers from a numeric name, the hosts file or the cache invoke callback before returning; otherwise it is invoked from process() or expire(), sharing the query of an identical lookup in flight
+			 *
+			 * @param const char* name - host name or numeric address
+			 * @param Family family - family of the addresses wanted
+			 * @param Callback callback - receives the outcome
+			 *
+			 * @return bool - whether callback was already invoked
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (EINVAL for a name which isn't a valid domain name)
+			 */
+			bool resolve(const char* name, Family family, Callback callback) noexcept(false) ;
+
+			/**
+			 * @brief fd - returns the nonblocking UDP socket connected to the nameserver, readable when answers arrive
+			 *
+			 * @return int - socket
+			 */
+			int fd() const noexcept ;
+
+			/**
+			 * @brief process - reads every pending answer & completes the lookups waiting on them
+			 *
+			 * @return size_t - number of queries completed
+			 *
+			 * @throws posicxx::Error - exception thrown upon error, or the first propagated from a callback (after every callback sharing that query has run)
+			 */
+			size_t process() noexcept(false) ;
+
+			/**
+			 * @brief expire - resends queries which timed out & fails those out of attempts with EAI_AGAIN
+			 *
+			 * @return size_t - number of queries failed
+			 *
+			 * @throws posicxx::Error - exception thrown upon error, or the first propagated from a callback (after every callback sharing that query has run)
+			 */
+			size_t expire() noexcept(false) ;
+
+			/**
+			 * @brief timeout - returns the time until the earliest query times out, for posicxx::Reactor::run_once
+			 *
+			 * @return int - milliseconds, or -1 if no query is in flight
+			 */
+			int timeout() const noexcept ;
+
+			/**
+			 * @brief pending - returns the number of queries in flight
+			 *
+			 * @return size_t - queries in flight
+			 */
+			size_t pending() const noexcept ;
+
+			/**
+			 * @brief cached - returns the number of cache entries, including expired ones not yet dropped
+			 *
+			 * @return size_t - cache entries
+			 */
+			size_t cached() const noexcept ;
+
+			/**
+			 * @brief flush - drops every cache entry
+			 */
+			void flush() noexcept ;
+
+			/**
+			 * @brief Resolver (destructor) - closes the socket; lookups in flight are abandoned without invoking their callbacks
+			 */
+			~Resolver() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			Resolver(const Resolver& resolver) noexcept = delete ;
+			Resolver& operator=(const Resolver& resolver) noexcept = delete ;
+			Resolver(Resolver&& resolver) noexcept = delete ;
+			Resolver& operator=(Resolver&& resolver) noexcept = delete ;
+	} ;
+
+#endif // #ifdef __linux__
+
+}
+
+#endif // #ifndef POSICXX_NETDB_HH
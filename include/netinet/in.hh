@@ -0,0 +1,248 @@
+#ifndef POSICXX_NETINET_IN_HH
+#define POSICXX_NETINET_IN_HH
+#pragma once
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+/**
+ * @brief netinet/in.hh - file serves as CXX declarations of internet protocol family functionality, containing the fancy interface
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/netinet/in.h.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief Endpoint (class) - IPv4 or IPv6 address & port as a compact value, for keying connection tables
+	 * 24 bytes with no padding, so copying, comparing & hashing work on three 64-bit words instead of walking a sockaddr
+	 * An IPv4 endpoint & its IPv4-mapped IPv6 form (::ffff:a.b.c.d) are distinct values
+	 */
+	class Endpoint {
+		private:
+			uint8_t _addr[16] ; // network byte order; IPv4 uses the first 4 bytes
+			uint32_t _scope ; // IPv6 scope (interface) id
+			uint16_t _port ; // host byte order
+			uint16_t _family ; // AF_INET, AF_INET6, or AF_UNSPEC for the empty endpoint
+
+			uint64_t _word(size_t i) const noexcept
+			{
+				uint64_t word ;
+				std::memcpy(&word, reinterpret_cast<const unsigned char*>(this) + i * sizeof(word), sizeof(word)) ;
+				return word ;
+			}
+
+		public:
+			/**
+			 * @brief Endpoint (constructor) - creates the empty endpoint, of family AF_UNSPEC
+			 */
+			constexpr Endpoint() noexcept : _addr{}, _scope(0), _port(0), _family(AF_UNSPEC)
+			{
+			}
+
+			/**
+			 * @brief v4 - creates an IPv4 endpoint
+			 *
+			 * @param uint32_t addr - address in host byte order, e.g. 0x7f000001 for 127.0.0.1
+			 * @param uint16_t port - port in host byte order
+			 *
+			 * @return Endpoint - the endpoint
+			 */
+			static constexpr Endpoint v4(uint32_t addr, uint16_t port) noexcept
+			{
+				Endpoint endpoint ;
+				endpoint._addr[0] = static_cast<uint8_t>(addr >> 24) ;
+				endpoint._addr[1] = static_cast<uint8_t>(addr >> 16) ;
+				endpoint._addr[2] = static_cast<uint8_t>(addr >> 8) ;
+				endpoint._addr[3] = static_cast<uint8_t>(addr) ;
+				endpoint._port = port ;
+				endpoint._family = AF_INET ;
+				return endpoint ;
+			}
+
+			/**
+			 * @brief v6 - creates an IPv6 endpoint
+			 *
+			 * @param const uint8_t (&addr)[16] - address in network byte order
+			 * @param uint16_t port - port in host byte order
+			 * @param uint32_t scope - scope id, for link-local addresses
+			 *
+			 * @return Endpoint - the endpoint
+			 */
+			static constexpr Endpoint v6(const uint8_t (&addr)[16], uint16_t port, uint32_t scope = 0) noexcept
+			{
+				Endpoint endpoint ;
+				for(size_t i = 0 ; i < 16 ; ++i)
+				{
+					endpoint._addr[i] = addr[i] ;
+				}
+				endpoint._scope = scope ;
+				endpoint._port = port ;
+				endpoint._family = AF_INET6 ;
+				return endpoint ;
+			}
+
+			/**
+			 * @brief from_sockaddr - creates an endpoint from a socket address, e.g. as filled in by posicxx::accept or posicxx::recvfrom
+			 *
+			 * @param const struct sockaddr* addr - socket address, of family AF_INET or AF_INET6
+			 * @param socklen_t addrlen - length of addr
+			 *
+			 * @return Endpoint - the endpoint
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (EAFNOSUPPORT for another family, EINVAL if addrlen is too short)
+			 */
+			static Endpoint from_sockaddr(const struct sockaddr* addr, socklen_t addrlen) noexcept(false) ;
+
+			/**
+			 * @brief to_sockaddr - writes the endpoint as a socket address, e.g. for posicxx::bind or posicxx::connect
+			 *
+			 * @param struct sockaddr_storage* addr - destination
+			 *
+			 * @return socklen_t - length of the address written, or 0 for the empty endpoint
+			 */
+			socklen_t to_sockaddr(struct sockaddr_storage* addr) const noexcept ;
+
+			/**
+			 * @brief format - writes the endpoint as text, "a.b.c.d:port" or "[v6]:port" (with "%scope" when set)
+			 *
+			 * @param char* dst - destination of the null-terminated text
+			 * @param size_t size - length of dst; 64 always suffices
+			 *
+			 * @return const char* - dst
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOSPC if dst is too short)
+			 */
+			const char* format(char* dst, size_t size) const noexcept(false) ;
+
+			/**
+			 * @brief family - returns the address family
+			 *
+			 * @return int - AF_INET, AF_INET6 or AF_UNSPEC
+			 */
+			constexpr int family() const noexcept
+			{
+				return this->_family ;
+			}
+
+			/**
+			 * @brief port - returns the port
+			 *
+			 * @return uint16_t - port in host byte order
+			 */
+			constexpr uint16_t port() const noexcept
+			{
+				return this->_port ;
+			}
+
+			/**
+			 * @brief scope - returns the IPv6 scope id
+			 *
+			 * @return uint32_t - scope id, 0 if none
+			 */
+			constexpr uint32_t scope() const noexcept
+			{
+				return this->_scope ;
+			}
+
+			/**
+			 * @brief address - returns the address bytes
+			 *
+			 * @return const uint8_t* - 4 (IPv4) or 16 (IPv6) bytes in network byte order
+			 */
+			constexpr const uint8_t* address() const noexcept
+			{
+				return this->_addr ;
+			}
+
+			/**
+			 * @brief hash - returns a well-mixed hash of the endpoint, suitable for open-addressing tables that mask off the low bits
+			 *
+			 * @return uint64_t - hash
+			 */
+			uint64_t hash() const noexcept
+			{
+				uint64_t h = this->_word(0) * 0x9e3779b97f4a7c15ULL ;
+				h ^= (h >> 29) ^ this->_word(1) * 0xc2b2ae3d27d4eb4fULL ;
+				h ^= (h >> 32) ^ this->_word(2) * 0x165667b19e3779f9ULL ;
+				h ^= h >> 29 ;
+				h *= 0xbf58476d1ce4e5b9ULL ;
+				return h ^ (h >> 32) ;
+			}
+
+			/**
+			 * @brief operator== - returns whether two endpoints have the same family, address, scope & port
+			 *
+			 * @param const Endpoint& other - endpoint to compare with
+			 *
+			 * @return bool - whether the endpoints are equal
+			 */
+			bool operator==(const Endpoint& other) const noexcept
+			{
+				return ((this->_word(0) ^ other._word(0)) | (this->_word(1) ^ other._word(1)) | (this->_word(2) ^ other._word(2))) == 0 ;
+			}
+
+			/**
+			 * @brief operator!= - returns whether two endpoints differ
+			 *
+			 * @param const Endpoint& other - endpoint to compare with
+			 *
+			 * @return bool - whether the endpoints differ
+			 */
+			bool operator!=(const Endpoint& other) const noexcept
+			{
+				return !(*this == other) ;
+			}
+
+			/**
+			 * @brief operator< - orders endpoints by address bytes, then scope, port & family, for ordered containers
+			 *
+			 * @param const Endpoint& other - endpoint to compare with
+			 *
+			 * @return bool - whether this endpoint orders first
+			 */
+			bool operator<(const Endpoint& other) const noexcept
+			{
+				const int order = std::memcmp(this->_addr, other._addr, sizeof(this->_addr)) ;
+				if(order != 0)
+				{
+					return order < 0 ;
+				}
+				if(this->_scope != other._scope)
+				{
+					return this->_scope < other._scope ;
+				}
+				if(this->_port != other._port)
+				{
+					return this->_port < other._port ;
+				}
+				return this->_family < other._family ;
+			}
+	} ;
+
+	static_assert(sizeof(Endpoint) == 24, "Endpoint is meant to be three 64-bit words without padding") ;
+	static_assert(std::is_trivially_copyable<Endpoint>::value, "Endpoint is meant to be copied as plain bytes") ;
+
+}
+
+namespace std {
+
+	/**
+	 * @brief hash<posicxx::Endpoint> - lets std::unordered_map / std::unordered_set key on endpoints
+	 */
+	template<>
+	struct hash<posicxx::Endpoint> {
+		size_t operator()(const posicxx::Endpoint& endpoint) const noexcept
+		{
+			return static_cast<size_t>(endpoint.hash()) ;
+		}
+	} ;
+
+}
+
+#endif // #ifndef POSICXX_NETINET_IN_HH
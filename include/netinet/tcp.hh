@@ -0,0 +1,399 @@
+#ifndef POSICXX_NETINET_TCP_HH
+#define POSICXX_NETINET_TCP_HH
+#pragma once
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+
+#include "sys/socket.hh"
+
+/**
+ * @brief netinet/tcp.hh - file serves as CXX declarations of TCP protocol functionality, containing the fancy interface
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/netinet/tcp.h.html for general details
+ */
+
+namespace posicxx {
+
+	namespace sockopt {
+
+		using tcp_maxseg = SocketOption<IPPROTO_TCP, TCP_MAXSEG, int> ;
+		using tcp_nodelay = SocketOption<IPPROTO_TCP, TCP_NODELAY, int> ;
+#ifdef TCP_CORK
+		using tcp_cork = SocketOption<IPPROTO_TCP, TCP_CORK, int> ;
+#endif // #ifdef TCP_CORK
+#ifdef TCP_KEEPIDLE
+		using tcp_keepcnt = SocketOption<IPPROTO_TCP, TCP_KEEPCNT, int> ;
+		using tcp_keepidle = SocketOption<IPPROTO_TCP, TCP_KEEPIDLE, int> ;
+		using tcp_keepintvl = SocketOption<IPPROTO_TCP, TCP_KEEPINTVL, int> ;
+#endif // #ifdef TCP_KEEPIDLE
+#ifdef TCP_QUICKACK
+		using tcp_quickack = SocketOption<IPPROTO_TCP, TCP_QUICKACK, int> ;
+#endif // #ifdef TCP_QUICKACK
+#ifdef TCP_NOTSENT_LOWAT
+		using tcp_notsent_lowat = SocketOption<IPPROTO_TCP, TCP_NOTSENT_LOWAT, int> ;
+#endif // #ifdef TCP_NOTSENT_LOWAT
+#ifdef TCP_USER_TIMEOUT
+		using tcp_user_timeout = SocketOption<IPPROTO_TCP, TCP_USER_TIMEOUT, unsigned> ;
+#endif // #ifdef TCP_USER_TIMEOUT
+
+	}
+
+	/**
+	 * @brief set_tcp_nodelay - enables or disables Nagle's algorithm on a TCP socket
+	 * On Linux, enabling it also pushes out any output held back, even while corked
+	 *
+	 * @param int sockfd - TCP socket
+	 * @param bool enable - whether small segments are sent immediately
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_tcp_nodelay(int sockfd, bool enable) noexcept(false) ;
+
+#if defined(TCP_CORK) && defined(MSG_MORE)
+
+	/**
+	 * @brief set_tcp_cork - corks or uncorks a TCP socket
+	 * Linux-specific. See https://man7.org/linux/man-pages/man7/tcp.7.html for more details
+	 * While corked only full segments are sent; uncorking sends whatever is held back. The kernel uncorks by itself after 200ms
+	 *
+	 * @param int sockfd - TCP socket
+	 * @param bool enable - whether partial segments are held back
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_tcp_cork(int sockfd, bool enable) noexcept(false) ;
+
+	/**
+	 * @brief CorkedWriter (class) - coalesces a response written in several pieces (headers, body chunks) into full TCP segments, rather than a segment per send
+	 * Linux-specific. Mode::more marks every send MSG_MORE & costs no extra calls; Mode::cork holds TCP_CORK from the first write to the flush, which also covers writes made behind the writer's back (e.g. posicxx::splice)
+	 * Either way the held-back tail leaves on flush, ideally by passing the last piece to it
+	 */
+	class CorkedWriter {
+		public:
+			enum class Mode {
+				more,
+				cork
+			} ;
+
+		private:
+			int _fd ;
+			Mode _mode ;
+			bool _corked ;
+
+			void _cork() noexcept(false) ;
+
+		public:
+			/**
+			 * @brief CorkedWriter (constructor) - wraps a connected TCP socket
+			 *
+			 * @param int sockfd - connected TCP socket; not owned, so it must outlive this object
+			 * @param Mode mode - how sends are held back
+			 */
+			explicit CorkedWriter(int sockfd, Mode mode = Mode::more) noexcept ;
+
+			/**
+			 * @brief write - sends a piece of a response, holding back a partial segment
+			 *
+			 * @param const void* buf - data to send
+			 * @param size_t len - length of data
+			 * @param int flags - send flags; MSG_MORE is added in Mode::more
+			 *
+			 * @return ssize_t - bytes sent, which may be fewer than len
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t write(const void* buf, size_t len, int flags = 0) noexcept(false) ;
+
+			/**
+			 * @brief write (overload) - sends a piece of a response gathered from several buffers, holding back a partial segment
+			 *
+			 * @param const struct iovec* iov - data to send
+			 * @param size_t iovlen - number of entries in `iov`
+			 * @param int flags - send flags; MSG_MORE is added in Mode::more
+			 *
+			 * @return ssize_t - bytes sent, which may be fewer than the total
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t write(const struct iovec* iov, size_t iovlen, int flags = 0) noexcept(false) ;
+
+			/**
+			 * @brief write (overload) - sends a piece of a response, holding back a partial segment
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param const void* buf - data to send
+			 * @param size_t len - length of data
+			 * @param int flags - send flags; MSG_MORE is added in Mode::more
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return ssize_t - bytes sent, or -1 upon error
+			 */
+			ssize_t write(const void* buf, size_t len, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief flush - sends the last piece of a response & everything held back with it
+			 * Saves a call over write() followed by flush()
+			 *
+			 * @param const void* buf - data to send
+			 * @param size_t len - length of data
+			 * @param int flags - send flags
+			 *
+			 * @return ssize_t - bytes sent, which may be fewer than len, in which case the rest should be sent with another flush
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t flush(const void* buf, size_t len, int flags = 0) noexcept(false) ;
+
+			/**
+			 * @brief flush (overload) - sends everything held back
+			 * In Mode::more this is done by posicxx::set_tcp_nodelay, which leaves Nagle's algorithm disabled on the socket
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void flush() noexcept(false) ;
+
+			/**
+			 * @brief mode - returns how sends are held back
+			 *
+			 * @return Mode - mode given on construction
+			 */
+			Mode mode() const noexcept ;
+
+			/**
+			 * @brief CorkedWriter (destructor) - uncorks the socket if still corked, ignoring errors
+			 */
+			~CorkedWriter() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			CorkedWriter() noexcept = delete ;
+			CorkedWriter(const CorkedWriter& writer) noexcept = delete ;
+			CorkedWriter& operator=(const CorkedWriter& writer) noexcept = delete ;
+			CorkedWriter(CorkedWriter&& writer) noexcept = delete ;
+			CorkedWriter& operator=(CorkedWriter&& writer) noexcept = delete ;
+	} ;
+
+#endif // #if defined(TCP_CORK) && defined(MSG_MORE)
+
+#ifdef TCP_INFO
+
+	/**
+	 * @brief TcpInfo (struct) - typed snapshot of the kernel's view of a TCP connection
+	 * Linux-specific. Decoded from struct tcp_info; see https://man7.org/linux/man-pages/man7/tcp.7.html
+	 */
+	struct TcpInfo {
+		uint8_t state ; // TCP_ESTABLISHED, ...
+		uint8_t ca_state ; // congestion avoidance state: TCP_CA_Open, TCP_CA_Recovery, ...
+		uint8_t retransmits ; // consecutive retransmission timeouts of the current segment
+		uint32_t rto_us ; // retransmission timeout
+		uint32_t rtt_us ; // smoothed round-trip time
+		uint32_t rttvar_us ; // round-trip time variance
+		uint32_t snd_mss ; // send maximum segment size
+		uint32_t rcv_mss ; // receive maximum segment size
+		uint32_t snd_cwnd ; // congestion window, in segments
+		uint32_t snd_ssthresh ; // slow start threshold, in segments
+		uint32_t unacked ; // segments sent but not yet acknowledged
+		uint32_t lost ; // segments deemed lost
+		uint32_t retrans ; // retransmitted segments not yet acknowledged
+		uint32_t total_retrans ; // segments retransmitted over the connection's life
+		uint32_t last_data_sent_ms ; // time since data was last sent
+		uint32_t last_data_recv_ms ; // time since data was last received
+	} ;
+
+	/**
+	 * @brief get_tcp_info - takes a snapshot of a TCP connection's statistics
+	 * A stub to posicxx::getsockopt with TCP_INFO - refer to it for more detail
+	 *
+	 * @param int sockfd - TCP socket
+	 *
+	 * @return TcpInfo - decoded statistics
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	TcpInfo get_tcp_info(int sockfd) noexcept(false) ;
+
+	/**
+	 * @brief get_tcp_info (overload) - takes a snapshot of a TCP connection's statistics
+	 * Non-throwing variant, for sockets which may have been closed in the meantime
+	 *
+	 * @param int sockfd - TCP socket
+	 * @param TcpInfo* info - where the statistics are stashed
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 */
+	void get_tcp_info(int sockfd, TcpInfo* info, std::error_code& ec) noexcept ;
+
+	/**
+	 * @brief TcpSampler (class) - samples the statistics of a set of connections into histograms of RTT, congestion window & retransmissions
+	 * Connections join & leave a fixed array of slots with a single compare-and-swap, & every histogram bucket is a relaxed atomic counter, so neither the connection path nor readers take locks
+	 * sample() is meant to be called at an interval from one thread, e.g. on a timer or via run(); while it reads a connection, that slot is marked busy, so remove() can wait out the read
+	 */
+	class TcpSampler {
+		public:
+			/**
+			 * @brief Histogram (class) - lock-free histogram with power-of-two buckets
+			 * Bucket 0 counts zeroes & bucket i counts values in [2^(i-1), 2^i)
+			 */
+			class Histogram {
+				public:
+					static constexpr size_t buckets = 65 ;
+
+				private:
+					std::atomic<uint64_t> _counts[buckets] ;
+
+				public:
+					/**
+					 * @brief Histogram (constructor) - creates an empty histogram
+					 */
+					Histogram() noexcept ;
+
+					/**
+					 * @brief record - counts a value
+					 *
+					 * @param uint64_t value - value to count
+					 */
+					void record(uint64_t value) noexcept ;
+
+					/**
+					 * @brief count - returns how many values landed in a bucket
+					 *
+					 * @param size_t bucket - index of bucket, less than buckets
+					 *
+					 * @return uint64_t - values counted
+					 */
+					uint64_t count(size_t bucket) const noexcept ;
+
+					/**
+					 * @brief total - returns how many values were counted
+					 *
+					 * @return uint64_t - values counted across all buckets
+					 */
+					uint64_t total() const noexcept ;
+
+					/**
+					 * @brief percentile - returns an upper bound on a quantile of the counted values
+					 *
+					 * @param double q - quantile, in [0, 1]
+					 *
+					 * @return uint64_t - exclusive upper bound of the bucket holding the quantile (0 if nothing was counted)
+					 */
+					uint64_t percentile(double q) const noexcept ;
+
+					/**
+					 * @brief reset - empties the histogram
+					 */
+					void reset() noexcept ;
+
+					/* Below are the defaulted and deleted methods */
+					Histogram(const Histogram& histogram) noexcept = delete ;
+					Histogram& operator=(const Histogram& histogram) noexcept = delete ;
+					Histogram(Histogram&& histogram) noexcept = delete ;
+					Histogram& operator=(Histogram&& histogram) noexcept = delete ;
+					~Histogram() noexcept = default ;
+			} ;
+
+		private:
+			size_t _capacity ;
+			std::unique_ptr<std::atomic<int>[]> _slots ; // -1 when free, the socket when tracked, -2 - socket while sample() reads it
+			Histogram _rtt ;
+			Histogram _cwnd ;
+			Histogram _retrans ;
+			std::atomic<uint64_t> _samples ;
+
+		public:
+			/**
+			 * @brief TcpSampler (constructor) - creates a sampler with room for a number of connections
+			 *
+			 * @param size_t capacity - most connections tracked at once
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			explicit TcpSampler(size_t capacity) noexcept(false) ;
+
+			/**
+			 * @brief add - starts sampling a connection
+			 *
+			 * @param int sockfd - TCP socket
+			 *
+			 * @return bool - whether a slot was free
+			 */
+			bool add(int sockfd) noexcept ;
+
+			/**
+			 * @brief remove - stops sampling a connection; call before closing it, so that a sample doesn't land on a reused descriptor
+			 * If sample() is reading the connection, waits for that read to finish, so once remove() returns the descriptor is no longer touched
+			 *
+			 * @param int sockfd - TCP socket passed to add()
+			 *
+			 * @return bool - whether the connection was being sampled
+			 */
+			bool remove(int sockfd) noexcept ;
+
+			/**
+			 * @brief sample - records one snapshot of every tracked connection; connections that error (e.g. already closed) are skipped
+			 *
+			 * @return size_t - connections sampled
+			 */
+			size_t sample() noexcept ;
+
+			/**
+			 * @brief run - calls sample() at an interval until told to stop
+			 *
+			 * @param unsigned interval_ms - milliseconds between samples
+			 * @param const std::atomic<bool>& running - sampling continues while true
+			 */
+			void run(unsigned interval_ms, const std::atomic<bool>& running) noexcept ;
+
+			/**
+			 * @brief rtt - returns the histogram of smoothed round-trip times, in microseconds
+			 *
+			 * @return const Histogram& - RTT histogram
+			 */
+			const Histogram& rtt() const noexcept ;
+
+			/**
+			 * @brief cwnd - returns the histogram of congestion windows, in segments
+			 *
+			 * @return const Histogram& - congestion window histogram
+			 */
+			const Histogram& cwnd() const noexcept ;
+
+			/**
+			 * @brief retrans - returns the histogram of lifetime retransmitted segments per connection
+			 *
+			 * @return const Histogram& - retransmission histogram
+			 */
+			const Histogram& retrans() const noexcept ;
+
+			/**
+			 * @brief samples - returns the number of connection snapshots recorded
+			 *
+			 * @return uint64_t - snapshots across all calls to sample()
+			 */
+			uint64_t samples() const noexcept ;
+
+			/**
+			 * @brief reset - empties every histogram, e.g. at the start of a reporting period
+			 */
+			void reset() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			TcpSampler() noexcept = delete ;
+			TcpSampler(const TcpSampler& sampler) noexcept = delete ;
+			TcpSampler& operator=(const TcpSampler& sampler) noexcept = delete ;
+			TcpSampler(TcpSampler&& sampler) noexcept = delete ;
+			TcpSampler& operator=(TcpSampler&& sampler) noexcept = delete ;
+			~TcpSampler() noexcept = default ;
+	} ;
+
+#endif // #ifdef TCP_INFO
+
+}
+
+#endif // #ifndef POSICXX_NETINET_TCP_HH
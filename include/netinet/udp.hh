@@ -0,0 +1,85 @@
+#ifndef POSICXX_NETINET_UDP_HH
+#define POSICXX_NETINET_UDP_HH
+#pragma once
+
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief netinet/udp.hh - file serves as CXX declarations of UDP protocol functionality, containing the fancy interface
+ * Segmentation offload (UDP_SEGMENT / UDP_GRO) is Linux-specific. See https://man7.org/linux/man-pages/man7/udp.7.html for general details
+ */
+
+namespace posicxx {
+
+#if defined(UDP_SEGMENT) && defined(UDP_GRO)
+
+	/**
+	 * @brief set_udp_gro - enables or disables generic receive offload on a UDP socket
+	 * With GRO enabled, consecutive datagrams of one flow may be delivered coalesced into a single read - see posicxx::recv_coalesced
+	 *
+	 * @param int sockfd - UDP socket
+	 * @param bool enable - whether to accept coalesced datagrams
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_udp_gro(int sockfd, bool enable) noexcept(false) ;
+
+	/**
+	 * @brief set_udp_segment - sets a socket-wide segment size, so that every send larger than it is split into datagrams of that size (generic segmentation offload)
+	 *
+	 * @param int sockfd - UDP socket
+	 * @param uint16_t segment_size - payload bytes per datagram. 0 disables segmentation
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_udp_segment(int sockfd, uint16_t segment_size) noexcept(false) ;
+
+	/**
+	 * @brief send_segmented - sends a buffer which the kernel (or NIC) splits into datagrams of `segment_size` payload bytes each, in one call
+	 * Builds the UDP_SEGMENT control message & hands it to posicxx::sendmsg. All but the last datagram carry exactly `segment_size` bytes
+	 * The total is bounded by the maximum IP datagram (64 KiB including headers) & by UDP_MAX_SEGMENTS datagrams
+	 *
+	 * @param int sockfd - UDP socket
+	 * @param const struct iovec* iov - payload segments, concatenated before being split
+	 * @param size_t iovlen - number of entries in `iov`
+	 * @param uint16_t segment_size - payload bytes per datagram
+	 * @param const struct sockaddr* addr - destination address (NULL for connected sockets)
+	 * @param socklen_t addrlen - length of `addr`
+	 * @param int flags - specifies type of message transmission
+	 *
+	 * @return ssize_t - bytes sent, across all datagrams
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t send_segmented(int sockfd, const struct iovec* iov, size_t iovlen, uint16_t segment_size, const struct sockaddr* addr, socklen_t addrlen, int flags) noexcept(false) ;
+
+	/**
+	 * @brief recv_coalesced - receives what may be several datagrams coalesced by GRO, along with the size they're to be split at
+	 * Parses the UDP_GRO control message from posicxx::recvmsg. Requires posicxx::set_udp_gro to have been enabled on the socket
+	 * The buffer holds datagrams of `*segment_size` bytes back to back, the last of which may be shorter
+	 * For the full benefit, `len` should allow for 64 KiB
+	 *
+	 * @param int sockfd - UDP socket
+	 * @param void* buf - destination of the payload
+	 * @param size_t len - length of `buf`
+	 * @param uint16_t* segment_size - where the datagram size is stashed. Equals the return value if nothing was coalesced
+	 * @param struct sockaddr* addr - where the source address is to be stashed (NULL if not wanted)
+	 * @param socklen_t* addrlen - on input: length of `addr`; on output: length of the stashed address
+	 * @param int flags - specifies type of message reception
+	 *
+	 * @return ssize_t - bytes received, across all datagrams
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t recv_coalesced(int sockfd, void* buf, size_t len, uint16_t* segment_size, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false) ;
+
+#endif // #if defined(UDP_SEGMENT) && defined(UDP_GRO)
+
+}
+
+#endif // #ifndef POSICXX_NETINET_UDP_HH
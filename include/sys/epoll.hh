@@ -0,0 +1,169 @@
+#ifndef POSICXX_SYS_EPOLL_HH
+#define POSICXX_SYS_EPOLL_HH
+#pragma once
+
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief sys/epoll.hh - file serves as CXX declarations of Linux's I/O event notification facility, containing the minimal wrapper, fancy interface and resource manager
+ * Linux-specific. See https://man7.org/linux/man-pages/man7/epoll.7.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief epoll_create1 - opens an epoll instance
+	 * See https://man7.org/linux/man-pages/man2/epoll_create1.2.html for more details
+	 *
+	 * @param int flags - 0 or EPOLL_CLOEXEC
+	 *
+	 * @return int - file descriptor referring to the epoll instance
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int epoll_create1(int flags) noexcept(false) ;
+
+	/**
+	 * @brief epoll_ctl - adds, modifies or removes an entry in the interest list of an epoll instance
+	 * See https://man7.org/linux/man-pages/man2/epoll_ctl.2.html for more details
+	 *
+	 * @param int epfd - epoll instance
+	 * @param int op - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+	 * @param int fd - file descriptor the operation applies to
+	 * @param struct epoll_event* event - events of interest & data to return with them. May be NULL for EPOLL_CTL_DEL
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void epoll_ctl(int epfd, int op, int fd, struct epoll_event* event) noexcept(false) ;
+
+	/**
+	 * @brief epoll_wait - waits for events on an epoll instance
+	 * See https://man7.org/linux/man-pages/man2/epoll_wait.2.html for more details
+	 * Being interrupted by a signal (EINTR) isn't treated as an error, but as a wait returning no events
+	 *
+	 * @param int epfd - epoll instance
+	 * @param struct epoll_event* events - where ready events are to be stashed
+	 * @param int maxevents - capacity of `events`
+	 * @param int timeout - milliseconds to wait for. -1 waits indefinitely, 0 doesn't wait
+	 *
+	 * @return int - number of events stashed
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int epoll_wait(int epfd, struct epoll_event* events, int maxevents, int timeout) noexcept(false) ;
+
+	/**
+	 * @brief Reactor (class) - edge-triggered event loop dispatching readiness of file descriptors to callbacks
+	 * Every registration is edge-triggered (EPOLLET): a callback is only invoked again once new readiness arrives, so it must read / write / accept until EAGAIN
+	 * The non-throwing overloads (e.g. posicxx::recv(..., std::error_code&)) suit this, as hitting EAGAIN is routine there
+	 * Callbacks may add, modify or remove any registration (including their own) and may stop the reactor
+	 */
+	class Reactor {
+		public:
+			/**
+			 * @brief Callback - invoked with the ready events (EPOLLIN, EPOLLOUT, EPOLLERR, EPOLLHUP, ...) of a descriptor
+			 */
+			using Callback = std::function<void(uint32_t events)> ;
+
+		private:
+			struct Handler {
+				int fd ;
+				Callback callback ;
+			} ;
+
+			int _epfd ;
+			int _wakefd ; // eventfd used by stop() to interrupt a waiting reactor from another thread
+			std::atomic<bool> _stopped ;
+			std::unordered_map<int, std::unique_ptr<Handler>> _handlers ;
+			std::vector<std::unique_ptr<Handler>> _removed ; // handlers removed mid-dispatch, kept alive until the batch has been dispatched
+			std::vector<struct epoll_event> _events ;
+
+			void _ctl(int op, int fd, uint32_t events, Handler* handler) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief Reactor (constructor) - opens an epoll instance
+			 *
+			 * @param size_t max_events - most events collected per wait
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			Reactor(size_t max_events = 256) noexcept(false) ;
+
+			/**
+			 * @brief add - registers a descriptor
+			 *
+			 * @param int fd - descriptor to watch. Not owned - remove it before closing it
+			 * @param uint32_t events - events of interest (e.g. EPOLLIN | EPOLLOUT | EPOLLRDHUP). EPOLLET is always added
+			 * EPOLLEXCLUSIVE may be given for listening sockets shared by several reactors, so a new connection wakes one of them rather than all. Such registrations can't be modified later, only removed
+			 * @param Callback callback - invoked with ready events
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. EEXIST if the descriptor is already registered
+			 */
+			void add(int fd, uint32_t events, Callback callback) noexcept(false) ;
+
+			/**
+			 * @brief modify - changes the events of interest for a registered descriptor
+			 *
+			 * @param int fd - registered descriptor
+			 * @param uint32_t events - new events of interest. EPOLLET is always added
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. ENOENT if the descriptor isn't registered
+			 */
+			void modify(int fd, uint32_t events) noexcept(false) ;
+
+			/**
+			 * @brief remove - unregisters a descriptor. Pending events for it in the current batch are dropped
+			 *
+			 * @param int fd - registered descriptor
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. ENOENT if the descriptor isn't registered
+			 */
+			void remove(int fd) noexcept(false) ;
+
+			/**
+			 * @brief run_once - waits for events once & dispatches them
+			 *
+			 * @param int timeout - milliseconds to wait for. -1 waits indefinitely, 0 doesn't wait
+			 *
+			 * @return size_t - number of callbacks invoked
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. Exceptions thrown by callbacks propagate
+			 */
+			size_t run_once(int timeout) noexcept(false) ;
+
+			/**
+			 * @brief run - dispatches events until stop() is called
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. Exceptions thrown by callbacks propagate
+			 */
+			void run() noexcept(false) ;
+
+			/**
+			 * @brief stop - makes the current (or next) run() return after its current batch. Safe to call from any thread
+			 */
+			void stop() noexcept ;
+
+			/**
+			 * @brief Reactor (destructor) - closes the epoll instance. Registered descriptors are left open
+			 */
+			~Reactor() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			Reactor(const Reactor& reactor) noexcept = delete ;
+			Reactor& operator=(const Reactor& reactor) noexcept = delete ;
+			Reactor(Reactor&& reactor) noexcept = delete ;
+			Reactor& operator=(Reactor&& reactor) noexcept = delete ;
+	} ;
+
+}
+
+#endif // #ifndef POSICXX_SYS_EPOLL_HH
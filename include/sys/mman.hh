@@ -0,0 +1,186 @@
+#ifndef POSICXX_SYS_MMAN_HH
+#define POSICXX_SYS_MMAN_HH
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+
+/**
+ * @brief sys/mman.hh - file serves as CXX declarations of POSIX memory management functionality, containing the minimal wrapper, fancy interface and resource manager
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/sys/mman.h.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief mmap - maps pages of memory
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/mmap.html for more details
+	 *
+	 * @param void* addr - preferred (or, with MAP_FIXED, required) address of the mapping
+	 * @param size_t len - length of the mapping
+	 * @param int prot - access permissions of the pages (PROT_READ, PROT_WRITE, PROT_EXEC OR'd together, or PROT_NONE)
+	 * @param int flags - MAP_SHARED or MAP_PRIVATE, OR'd with additional preferences
+	 * @param int fildes - open file descriptor of the object to map
+	 * @param off_t off - offset into the object to map from
+	 *
+	 * @return void* - address of the mapping
+	 * Will not be MAP_FAILED as an exception will be thrown if this is the case
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void* mmap(void* addr, size_t len, int prot, int flags, int fildes, off_t off) noexcept(false) ;
+
+	/**
+	 * @brief mprotect - sets protection of memory mapping
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/mprotect.html for more details
+	 *
+	 * @param void* addr - page-aligned start of the range
+	 * @param size_t len - length of the range
+	 * @param int prot - new access permissions of the pages
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void mprotect(void* addr, size_t len, int prot) noexcept(false) ;
+
+#ifdef __linux__
+
+	/**
+	 * @brief mremap - expands (or shrinks) an existing memory mapping, potentially moving it
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/mremap.2.html for more details
+	 *
+	 * @param void* old_address - page-aligned start of the existing mapping
+	 * @param size_t old_size - size of the existing mapping
+	 * @param size_t new_size - requested size
+	 * @param int flags - 0 or MREMAP_MAYMOVE
+	 *
+	 * @return void* - address of the resized mapping
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void* mremap(void* old_address, size_t old_size, size_t new_size, int flags) noexcept(false) ;
+
+#endif // #ifdef __linux__
+
+	/**
+	 * @brief msync - synchronises memory with physical storage
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/msync.html for more details
+	 *
+	 * @param void* addr - page-aligned start of the range
+	 * @param size_t len - length of the range
+	 * @param int flags - MS_ASYNC or MS_SYNC, optionally OR'd with MS_INVALIDATE
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void msync(void* addr, size_t len, int flags) noexcept(false) ;
+
+	/**
+	 * @brief munmap - unmaps pages of memory
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/munmap.html for more details
+	 *
+	 * @param void* addr - page-aligned start of the range
+	 * @param size_t len - length of the range
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void munmap(void* addr, size_t len) noexcept(false) ;
+
+	/**
+	 * @brief posix_madvise - memory advisory information and alignment control
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/posix_madvise.html for more details
+	 *
+	 * @param void* addr - page-aligned start of the range
+	 * @param size_t len - length of the range
+	 * @param int advice - the advice (e.g. POSIX_MADV_SEQUENTIAL)
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void posix_madvise(void* addr, size_t len, int advice) noexcept(false) ;
+
+	/**
+	 * @brief GrowableMapping (class) - shared mapping of a file which can grow in place, so pointers into it remain valid
+	 * A large range of address space is reserved up front (PROT_NONE, no backing, no commit charge). Growing extends the file in whole chunks & maps the new pages over the next part of the reservation with MAP_FIXED
+	 * Unlike remapping (or mremap without MREMAP_MAYMOVE, which fails once a neighbouring mapping is in the way), the mapping never moves
+	 */
+	class GrowableMapping {
+		private:
+			int _fd ; // file being mapped, not owned
+			char* _base ; // start of the reservation
+			size_t _reserved ; // bytes of address space reserved
+			size_t _chunk ; // granularity the file is extended in
+			size_t _size ; // bytes of the file known to exist
+			size_t _mapped ; // bytes of the reservation mapped to the file (_size rounded up to pages)
+			int _prot ;
+
+			void _map(size_t size) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief GrowableMapping (constructor) - reserves address space & maps the current contents of a file
+			 *
+			 * @param int fd - open file descriptor, whose access mode must allow `prot`. Not owned, must outlive the mapping
+			 * @param size_t reserve - bytes of address space to reserve, i.e. the most the mapping may ever grow to. Rounded up to pages
+			 * @param size_t chunk - granularity the file is extended in when growing. Rounded up to pages
+			 * @param int prot - access permissions of the mapping
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. ENOMEM if the file is already larger than `reserve`
+			 */
+			GrowableMapping(int fd, size_t reserve, size_t chunk, int prot = PROT_READ | PROT_WRITE) noexcept(false) ;
+
+			/**
+			 * @brief data - returns the start of the mapping. Never changes over the mapping's lifetime
+			 *
+			 * @return char* - start of the mapping
+			 */
+			char* data() const noexcept ;
+
+			/**
+			 * @brief size - returns the number of bytes of the file currently mapped
+			 *
+			 * @return size_t - usable bytes from data()
+			 */
+			size_t size() const noexcept ;
+
+			/**
+			 * @brief reserved - returns the most the mapping may grow to
+			 *
+			 * @return size_t - bytes of address space reserved
+			 */
+			size_t reserved() const noexcept ;
+
+			/**
+			 * @brief grow - ensures at least `size` bytes of the file exist & are mapped
+			 * The file is extended with posix_fallocate (falling back to ftruncate where the file system can't allocate) to the next multiple of the chunk size
+			 *
+			 * @param size_t size - bytes wanted from data()
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. ENOMEM if `size` is beyond the reservation
+			 */
+			void grow(size_t size) noexcept(false) ;
+
+			/**
+			 * @brief sync - writes the mapped pages back to the file
+			 * A stub to posicxx::msync - refer to it for more detail
+			 *
+			 * @param int flags - MS_ASYNC or MS_SYNC, optionally OR'd with MS_INVALIDATE
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void sync(int flags) noexcept(false) ;
+
+			/**
+			 * @brief GrowableMapping (destructor) - unmaps the whole reservation. The file keeps its extended size
+			 */
+			~GrowableMapping() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			GrowableMapping() noexcept = delete ;
+			GrowableMapping(const GrowableMapping& mapping) noexcept = delete ;
+			GrowableMapping& operator=(const GrowableMapping& mapping) noexcept = delete ;
+			GrowableMapping(GrowableMapping&& mapping) noexcept = delete ;
+			GrowableMapping& operator=(GrowableMapping&& mapping) noexcept = delete ;
+	} ;
+
+}
+
+#endif // #ifndef POSICXX_SYS_MMAN_HH
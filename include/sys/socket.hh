@@ -4,6 +4,21 @@
 
 #include <sys/socket.h>
 
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#endif // #ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+
 #include "unistd.hh"
 
 /**
@@ -13,6 +28,45 @@
 
 namespace posicxx {
 
+	/**
+	 * @brief SocketOption (struct) - compile-time descriptor of a socket option: the level & name it lives at & the type of its value
+	 * Passed as the template argument of posicxx::setsockopt / posicxx::getsockopt, so the value's type & size are checked by the compiler rather than at runtime
+	 * Common options are predefined in posicxx::sockopt
+	 */
+	template<int Level, int Name, typename T>
+	struct SocketOption {
+		static_assert(std::is_trivially_copyable<T>::value, "socket option values are copied bytewise") ;
+
+		static constexpr int level = Level ;
+		static constexpr int name = Name ;
+		using type = T ;
+	} ;
+
+	namespace sockopt {
+
+		using broadcast = SocketOption<SOL_SOCKET, SO_BROADCAST, int> ;
+		using error = SocketOption<SOL_SOCKET, SO_ERROR, int> ;
+		using keepalive = SocketOption<SOL_SOCKET, SO_KEEPALIVE, int> ;
+		using linger = SocketOption<SOL_SOCKET, SO_LINGER, struct ::linger> ;
+		using rcvbuf = SocketOption<SOL_SOCKET, SO_RCVBUF, int> ;
+		using rcvlowat = SocketOption<SOL_SOCKET, SO_RCVLOWAT, int> ;
+		using rcvtimeo = SocketOption<SOL_SOCKET, SO_RCVTIMEO, struct timeval> ;
+		using reuseaddr = SocketOption<SOL_SOCKET, SO_REUSEADDR, int> ;
+		using sndbuf = SocketOption<SOL_SOCKET, SO_SNDBUF, int> ;
+		using sndtimeo = SocketOption<SOL_SOCKET, SO_SNDTIMEO, struct timeval> ;
+		using type = SocketOption<SOL_SOCKET, SO_TYPE, int> ;
+#ifdef SO_REUSEPORT
+		using reuseport = SocketOption<SOL_SOCKET, SO_REUSEPORT, int> ;
+#endif // #ifdef SO_REUSEPORT
+#ifdef SO_BUSY_POLL
+		using busy_poll = SocketOption<SOL_SOCKET, SO_BUSY_POLL, int> ;
+#endif // #ifdef SO_BUSY_POLL
+#ifdef SO_INCOMING_CPU
+		using incoming_cpu = SocketOption<SOL_SOCKET, SO_INCOMING_CPU, int> ;
+#endif // #ifdef SO_INCOMING_CPU
+
+	}
+
 	/**
 	 * @brief accept - accepts a new connection on a socket
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/accept.html for more details
@@ -27,6 +81,55 @@ namespace posicxx {
 	 */
 	int accept(int sockfd, struct sockaddr* addr, socklen_t* addrlen) noexcept(false) ;
 
+	/**
+	 * @brief accept (overload) - accepts a new connection on a socket
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/accept.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int socket - bound socket awaiting connections
+	 * @param struct sockaddr* addr - the address of the connecting socket
+	 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return int - positive integer file handle, or -1 upon error
+	 */
+	int accept(int sockfd, struct sockaddr* addr, socklen_t* addrlen, std::error_code& ec) noexcept ;
+
+#ifdef __linux__
+
+	/**
+	 * @brief accept4 - accepts a new connection on a socket, with flags set atomically upon creation
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/accept4.2.html for more details
+	 * Saves the two posicxx::fcntl calls otherwise needed per connection to set O_NONBLOCK and FD_CLOEXEC
+	 *
+	 * @param int socket - bound socket awaiting connections
+	 * @param struct sockaddr* addr - the address of the connecting socket
+	 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+	 * @param int flags - 0 or any of SOCK_CLOEXEC, SOCK_NONBLOCK OR'd together
+	 *
+	 * @return int - positive integer file handle
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int accept4(int sockfd, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false) ;
+
+	/**
+	 * @brief accept4 (overload) - accepts a new connection on a socket, with flags set atomically upon creation
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/accept4.2.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int socket - bound socket awaiting connections
+	 * @param struct sockaddr* addr - the address of the connecting socket
+	 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+	 * @param int flags - 0 or any of SOCK_CLOEXEC, SOCK_NONBLOCK OR'd together
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return int - positive integer file handle, or -1 upon error
+	 */
+	int accept4(int sockfd, struct sockaddr* addr, socklen_t* addrlen, int flags, std::error_code& ec) noexcept ;
+
+#endif // #ifdef __linux__
+
 	/**
 	 * @brief bind - binds a local name to a socket
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/bind.html for more details
@@ -89,6 +192,30 @@ namespace posicxx {
 	 */
 	void getsockopt(int sockfd, int level, int optname, void* optval, socklen_t* optlen) noexcept(false) ;
 
+	/**
+	 * @brief getsockopt (overload) - get a socket option described at compile time
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getsockopt.html for more details
+	 *
+	 * @tparam Option - posicxx::SocketOption descriptor, e.g. posicxx::sockopt::rcvbuf
+	 *
+	 * @param int sockfd - socket to retrieve configurations of
+	 *
+	 * @return typename Option::type - value of the option
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	template<typename Option>
+	typename Option::type getsockopt(int sockfd) noexcept(false)
+	{
+		typename Option::type value{} ;
+		socklen_t len = sizeof(value) ;
+		if(::getsockopt(sockfd, Option::level, Option::name, &value, &len) != 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+		return value ;
+	}
+
 	/**
 	 * @brief listen - listen & queue (a capped) incoming connections
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getsockopt.html for more details
@@ -115,6 +242,21 @@ namespace posicxx {
 	 */
 	ssize_t recv(int sockfd, void* buf, size_t len, int flags) noexcept(false) ;
 
+	/**
+	 * @brief recv (overload) - receive a message from a connection-mode socket
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/recv.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connection-configured socket
+	 * @param void* buf - message destination
+	 * @param size_t len - length of supplied buffer
+	 * @param int flags - specifies type of message reception
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return ssize_t - length of message stashed, or -1 upon error
+	 */
+	ssize_t recv(int sockfd, void* buf, size_t len, int flags, std::error_code& ec) noexcept ;
+
 	/**
 	 * @brief recvfrom - receive a message from a connection-mode or connectionless-mode socket, providing source details
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/recvfrom.html for more details
@@ -132,6 +274,42 @@ namespace posicxx {
 	 */
 	ssize_t recvfrom(int sockfd, void* buf, size_t len, int flags, struct sockaddr* src_addr, socklen_t* addrlen) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief recvmmsg - receive multiple messages from a socket in one call
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/recvmmsg.2.html for more details
+	 *
+	 * @param int sockfd - socket to receive from
+	 * @param struct mmsghdr* msgvec - array of message headers, each as for posicxx::recvmsg. msg_len of each is set to the bytes received
+	 * @param unsigned vlen - number of headers in `msgvec`
+	 * @param int flags - specifies type of message reception (e.g. MSG_DONTWAIT, MSG_WAITFORONE)
+	 * @param struct timespec* timeout - time to wait for further messages once one has arrived (NULL for none)
+	 *
+	 * @return int - number of messages received
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, struct timespec* timeout) noexcept(false) ;
+
+	/**
+	 * @brief recvmmsg (overload) - receive multiple messages from a socket in one call
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/recvmmsg.2.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - socket to receive from
+	 * @param struct mmsghdr* msgvec - array of message headers, each as for posicxx::recvmsg. msg_len of each is set to the bytes received
+	 * @param unsigned vlen - number of headers in `msgvec`
+	 * @param int flags - specifies type of message reception (e.g. MSG_DONTWAIT, MSG_WAITFORONE)
+	 * @param struct timespec* timeout - time to wait for further messages once one has arrived (NULL for none)
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return int - number of messages received, or -1 upon error
+	 */
+	int recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, struct timespec* timeout, std::error_code& ec) noexcept ;
+
+#endif // #ifdef __linux__
+
 	/**
 	 * @brief recvmsg - receive a message from a connection-mode or connectionless-mode socket, providing source details & finer buffer control
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/recvmsg.html for more details
@@ -146,6 +324,20 @@ namespace posicxx {
 	 */
 	ssize_t recvmsg(int sockfd, struct msghdr* msg, int flags) noexcept(false) ;
 
+	/**
+	 * @brief recvmsg (overload) - receive a message from a connection-mode or connectionless-mode socket, providing source details & finer buffer control
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/recvmsg.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connection-configured socket
+	 * @param struct msghdr* msg - buffer for source information and message contents
+	 * @param int flags - specifies type of message reception
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return ssize_t - length of message stashed, or -1 upon error
+	 */
+	ssize_t recvmsg(int sockfd, struct msghdr* msg, int flags, std::error_code& ec) noexcept ;
+
 	/**
 	 * @brief send - sends a message from a connection-mode socket
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/send.html for more details
@@ -161,6 +353,21 @@ namespace posicxx {
 	 */
 	ssize_t send(int sockfd, const void* buf, size_t len, int flags);
 
+	/**
+	 * @brief send (overload) - sends a message from a connection-mode socket
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/send.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connection-configured socket
+	 * @param const void* buf - message source
+	 * @param size_t len - length of supplied buffer
+	 * @param int flags - specifies type of message reception
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return ssize_t - length of message supplied and sent, or -1 upon error
+	 */
+	ssize_t send(int sockfd, const void* buf, size_t len, int flags, std::error_code& ec) noexcept ;
+
 	/**
 	 * @brief sendto - sends a message on a connection-mode or connectionless-mode socket
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/sendto.html for more details
@@ -178,6 +385,40 @@ namespace posicxx {
 	 */
 	ssize_t sendto(int sockfd, const void* buf, size_t len, int flags, const struct sockaddr* dest_addr, socklen_t addrlen) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief sendmmsg - sends multiple messages on a socket in one call
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/sendmmsg.2.html for more details
+	 *
+	 * @param int sockfd - socket to send on
+	 * @param struct mmsghdr* msgvec - array of message headers, each as for posicxx::sendmsg. msg_len of each is set to the bytes sent
+	 * @param unsigned vlen - number of headers in `msgvec`
+	 * @param int flags - specifies type of message transmission
+	 *
+	 * @return int - number of messages sent, which may be fewer than `vlen`
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags) noexcept(false) ;
+
+	/**
+	 * @brief sendmmsg (overload) - sends multiple messages on a socket in one call
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/sendmmsg.2.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - socket to send on
+	 * @param struct mmsghdr* msgvec - array of message headers, each as for posicxx::sendmsg. msg_len of each is set to the bytes sent
+	 * @param unsigned vlen - number of headers in `msgvec`
+	 * @param int flags - specifies type of message transmission
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return int - number of messages sent, or -1 upon error
+	 */
+	int sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, std::error_code& ec) noexcept ;
+
+#endif // #ifdef __linux__
+
 	/**
 	 * @brief sendmsg - sends a message from a connection-mode or connectionless-mode socket, providing destination details & finer buffer control
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/sendmsg.html for more details
@@ -192,6 +433,20 @@ namespace posicxx {
 	 */
 	ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags) noexcept(false) ;
 
+	/**
+	 * @brief sendmsg (overload) - sends a message from a connection-mode or connectionless-mode socket, providing destination details & finer buffer control
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/sendmsg.html for more details
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connection-configured socket
+	 * @param struct msghdr* msg - buffer for destination information and message contents
+	 * @param int flags - specifies type of message transmission
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise
+	 *
+	 * @return ssize_t - length of message supplied and sent, or -1 upon error
+	 */
+	ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags, std::error_code& ec) noexcept ;
+
 	/**
 	 * @brief setsockopt - sets specified socket option
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/setsockopt.html for more details
@@ -206,6 +461,26 @@ namespace posicxx {
 	 */
 	void setsockopt(int sockfd, int level, int optname, const void* optval, socklen_t optlen) noexcept(false) ;
 
+	/**
+	 * @brief setsockopt (overload) - sets a socket option described at compile time
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/setsockopt.html for more details
+	 *
+	 * @tparam Option - posicxx::SocketOption descriptor, e.g. posicxx::sockopt::rcvbuf
+	 *
+	 * @param int sockfd - socket to set configurations of
+	 * @param const typename Option::type& value - value of the option
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	template<typename Option>
+	void setsockopt(int sockfd, const typename Option::type& value) noexcept(false)
+	{
+		if(::setsockopt(sockfd, Option::level, Option::name, &value, sizeof(value)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+	}
+
 	/**
 	 * @brief shutdown - shut down sockets future send and receive operations
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/shutdown.html for more details
@@ -224,6 +499,7 @@ namespace posicxx {
 	 * @param int domain - communications domain in which a socket is created
 	 *
 	 * @param int type - type of socket intended
+	 * On Linux, SOCK_NONBLOCK and / or SOCK_CLOEXEC may be OR'd in so the descriptor is created with them set
 	 *
 	 * @param int protocol - protocol to be used with socket
 	 * 0 causes default protocol for given socket type to be selected
@@ -253,6 +529,7 @@ namespace posicxx {
 	 * @param int domain - communications domain in which a socket is created
 	 *
 	 * @param int type - type of socket intended
+	 * On Linux, SOCK_NONBLOCK and / or SOCK_CLOEXEC may be OR'd in so the descriptor is created with them set
 	 *
 	 * @param int protocol - protocol to be used with socket
 	 * 0 causes default protocol for given socket type to be selected
@@ -263,6 +540,1208 @@ namespace posicxx {
 	 */
 	void socketpair(int domain, int type, int protocol, int sv[2]) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief DatagramBatch (class) - preallocated arena of message headers, iovecs, buffers & addresses for moving many datagrams per call with posicxx::recvmmsg / posicxx::sendmmsg
+	 * Everything is allocated once at construction & reused by every call, so the data path doesn't allocate
+	 */
+	class DatagramBatch {
+		public:
+			/**
+			 * @brief Datagram (struct) - view of one datagram held in the batch, valid until the batch is next received into or cleared
+			 */
+			struct Datagram {
+				char* data ; // payload
+				size_t size ; // bytes of payload
+				const struct sockaddr* addr ; // source (after receiving) / destination (when sending) address
+				socklen_t addrlen ; // length of `addr`, 0 if there is none
+				int flags ; // msg_flags reported for the datagram, e.g. MSG_TRUNC if it didn't fit its slot
+			} ;
+
+		private:
+			size_t _slots ; // number of datagrams the batch holds
+			size_t _slot_size ; // bytes of buffer per datagram
+			size_t _count ; // datagrams currently held
+			std::unique_ptr<char[]> _buffers ;
+			std::unique_ptr<struct mmsghdr[]> _headers ;
+			std::unique_ptr<struct iovec[]> _iovecs ;
+			std::unique_ptr<struct sockaddr_storage[]> _addrs ;
+			std::unique_ptr<Datagram[]> _datagrams ;
+
+			void _arm(size_t count) noexcept ;
+			void _collect(size_t count) noexcept ;
+
+		public:
+			/**
+			 * @brief DatagramBatch (constructor) - allocates the arena
+			 *
+			 * @param size_t slots - most datagrams moved per call
+			 * @param size_t slot_size - bytes of buffer per datagram. Larger datagrams are truncated on receipt
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			DatagramBatch(size_t slots, size_t slot_size) noexcept(false) ;
+
+			/**
+			 * @brief recv - receives up to a full batch of datagrams, replacing those held
+			 * A stub to posicxx::recvmmsg - refer to it for more detail
+			 *
+			 * @param int sockfd - socket to receive from
+			 * @param int flags - specifies type of message reception (e.g. MSG_DONTWAIT, MSG_WAITFORONE)
+			 *
+			 * @return size_t - number of datagrams received, also available through size() / begin() / end()
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t recv(int sockfd, int flags) noexcept(false) ;
+
+			/**
+			 * @brief recv (overload) - receives up to a full batch of datagrams, replacing those held
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param int sockfd - socket to receive from
+			 * @param int flags - specifies type of message reception (e.g. MSG_DONTWAIT, MSG_WAITFORONE)
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return size_t - number of datagrams received. 0 upon error
+			 */
+			size_t recv(int sockfd, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief push - copies a datagram into the next free slot, to be sent by send()
+			 *
+			 * @param const void* data - payload
+			 * @param size_t len - bytes of payload. At most the slot size
+			 * @param const struct sockaddr* addr - destination address (NULL for connected sockets)
+			 * @param socklen_t addrlen - length of `addr`
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. ENOBUFS if the batch is full, EMSGSIZE if the payload exceeds the slot size
+			 */
+			void push(const void* data, size_t len, const struct sockaddr* addr, socklen_t addrlen) noexcept(false) ;
+
+			/**
+			 * @brief send - sends the held datagrams from `first` onwards
+			 * A stub to posicxx::sendmmsg - refer to it for more detail
+			 *
+			 * @param int sockfd - socket to send on
+			 * @param int flags - specifies type of message transmission
+			 * @param size_t first - index of the first datagram to send, e.g. to resume after a partial send
+			 *
+			 * @return size_t - number of datagrams sent, which may be fewer than asked
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t send(int sockfd, int flags, size_t first = 0) noexcept(false) ;
+
+			/**
+			 * @brief send (overload) - sends the held datagrams from `first` onwards
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param int sockfd - socket to send on
+			 * @param int flags - specifies type of message transmission
+			 * @param size_t first - index of the first datagram to send
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return size_t - number of datagrams sent. 0 upon error
+			 */
+			size_t send(int sockfd, int flags, size_t first, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief clear - discards the held datagrams
+			 */
+			void clear() noexcept ;
+
+			/**
+			 * @brief size - returns the number of datagrams held
+			 *
+			 * @return size_t - datagrams held
+			 */
+			size_t size() const noexcept ;
+
+			/**
+			 * @brief capacity - returns the number of datagrams the batch can hold
+			 *
+			 * @return size_t - slots in the arena
+			 */
+			size_t capacity() const noexcept ;
+
+			/**
+			 * @brief operator[] - returns a held datagram
+			 *
+			 * @param size_t index - index of datagram, less than size()
+			 *
+			 * @return const Datagram& - view of the datagram
+			 */
+			const Datagram& operator[](size_t index) const noexcept ;
+
+			/**
+			 * @brief begin - returns the start of the held datagrams, for range-based iteration
+			 *
+			 * @return const Datagram* - first datagram
+			 */
+			const Datagram* begin() const noexcept ;
+
+			/**
+			 * @brief end - returns the end of the held datagrams, for range-based iteration
+			 *
+			 * @return const Datagram* - one past the last datagram
+			 */
+			const Datagram* end() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			DatagramBatch() noexcept = delete ;
+			DatagramBatch(const DatagramBatch& batch) noexcept = delete ;
+			DatagramBatch& operator=(const DatagramBatch& batch) noexcept = delete ;
+			DatagramBatch(DatagramBatch&& batch) noexcept = default ;
+			DatagramBatch& operator=(DatagramBatch&& batch) noexcept = default ;
+			~DatagramBatch() noexcept = default ;
+	} ;
+
+#endif // #ifdef __linux__
+
+#ifdef SO_REUSEPORT
+
+	/**
+	 * @brief ShardedListener (class) - one listening socket per worker, all bound to the same address with SO_REUSEPORT
+	 * The kernel spreads incoming connections across the shards' separate accept queues, so workers don't contend on a shared one
+	 * Optionally, a classic BPF program steers each connection to shard (receiving CPU % shards), so a worker pinned to CPU i handling shard i keeps its connections' processing on that CPU
+	 */
+	class ShardedListener {
+		private:
+			struct Shard {
+				int fd ;
+				std::atomic<unsigned long long> accepted ;
+				char pad[64] ; // keeps each shard's counter off its neighbours' cache lines
+			} ;
+
+			size_t _count ;
+			std::unique_ptr<Shard[]> _shards ;
+
+			void _close() noexcept ;
+
+		public:
+			/**
+			 * @brief ShardedListener (constructor) - creates, binds & starts listening on every shard
+			 *
+			 * @param const struct sockaddr* addr - address to listen on. If its port is 0, the port picked for the first shard is used for the rest
+			 * @param socklen_t addrlen - length of `addr`
+			 * @param size_t shards - number of listening sockets, typically one per worker / core
+			 * @param int backlog - accept queue limit of each shard
+			 * @param int type - socket type, optionally OR'd with SOCK_NONBLOCK / SOCK_CLOEXEC (e.g. SOCK_STREAM | SOCK_NONBLOCK)
+			 * @param bool steer - whether to attach the CPU steering program (SO_ATTACH_REUSEPORT_CBPF)
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ShardedListener(const struct sockaddr* addr, socklen_t addrlen, size_t shards, int backlog, int type, bool steer) noexcept(false) ;
+
+			/**
+			 * @brief size - returns the number of shards
+			 *
+			 * @return size_t - number of listening sockets
+			 */
+			size_t size() const noexcept ;
+
+			/**
+			 * @brief fd - returns a shard's listening socket, e.g. to register with a posicxx::Reactor
+			 *
+			 * @param size_t shard - index of shard
+			 *
+			 * @return int - listening socket
+			 */
+			int fd(size_t shard) const noexcept ;
+
+			/**
+			 * @brief accept - accepts a connection from a shard's queue, counting it
+			 * A stub to posicxx::accept - refer to it for more detail
+			 *
+			 * @param size_t shard - index of shard
+			 * @param struct sockaddr* addr - the address of the connecting socket
+			 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+			 *
+			 * @return int - positive integer file handle
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			int accept(size_t shard, struct sockaddr* addr, socklen_t* addrlen) noexcept(false) ;
+
+			/**
+			 * @brief accept (overload) - accepts a connection from a shard's queue, counting it
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param size_t shard - index of shard
+			 * @param struct sockaddr* addr - the address of the connecting socket
+			 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return int - positive integer file handle, or -1 upon error
+			 */
+			int accept(size_t shard, struct sockaddr* addr, socklen_t* addrlen, std::error_code& ec) noexcept ;
+
+#ifdef __linux__
+
+			/**
+			 * @brief accept4 - accepts a connection from a shard's queue with flags set atomically upon creation, counting it
+			 * A stub to posicxx::accept4 - refer to it for more detail
+			 *
+			 * @param size_t shard - index of shard
+			 * @param struct sockaddr* addr - the address of the connecting socket
+			 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+			 * @param int flags - 0 or any of SOCK_CLOEXEC, SOCK_NONBLOCK OR'd together
+			 *
+			 * @return int - positive integer file handle
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			int accept4(size_t shard, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false) ;
+
+			/**
+			 * @brief accept4 (overload) - accepts a connection from a shard's queue with flags set atomically upon creation, counting it
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param size_t shard - index of shard
+			 * @param struct sockaddr* addr - the address of the connecting socket
+			 * @param socklen_t* addrlen - on input: specifies the length of the supplied sockaddr structure; on output: specifies the length of the stashed address
+			 * @param int flags - 0 or any of SOCK_CLOEXEC, SOCK_NONBLOCK OR'd together
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return int - positive integer file handle, or -1 upon error
+			 */
+			int accept4(size_t shard, struct sockaddr* addr, socklen_t* addrlen, int flags, std::error_code& ec) noexcept ;
+
+#endif // #ifdef __linux__
+
+			/**
+			 * @brief accepted - returns the number of connections accepted from a shard
+			 *
+			 * @param size_t shard - index of shard
+			 *
+			 * @return unsigned long long - connections accepted through this object
+			 */
+			unsigned long long accepted(size_t shard) const noexcept ;
+
+			/**
+			 * @brief ShardedListener (destructor) - closes every shard
+			 */
+			~ShardedListener() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			ShardedListener() noexcept = delete ;
+			ShardedListener(const ShardedListener& listener) noexcept = delete ;
+			ShardedListener& operator=(const ShardedListener& listener) noexcept = delete ;
+			ShardedListener(ShardedListener&& listener) noexcept = delete ;
+			ShardedListener& operator=(ShardedListener&& listener) noexcept = delete ;
+	} ;
+
+#endif // #ifdef SO_REUSEPORT
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
+	struct Timestamp ;
+
+	/**
+	 * @brief ZeroCopySender (class) - sends from caller-owned buffers with MSG_ZEROCOPY, so the kernel pins the pages instead of copying them
+	 * Each successful send is numbered by the kernel & completes later through the socket error queue; reap() drains it & hands each buffer back once the kernel is done with it
+	 * The error queue signals readiness with EPOLLERR, so a posicxx::Reactor handler can call reap() whenever that bit is set
+	 * TX timestamps (posicxx::set_timestamping) share that queue: on a socket with both, drain it only through reap(release, stamped), never posicxx::tx_timestamps, as each would discard the other's notifications
+	 * Only worthwhile for large writes (roughly 10KB & up); small ones cost more in page pinning & notifications than the copy they save
+	 */
+	class ZeroCopySender {
+		private:
+			struct Pending {
+				const void* data ;
+				size_t size ;
+				bool done ;
+			} ;
+
+			int _fd ;
+			uint32_t _head ;
+			std::deque<Pending> _pending ;
+			unsigned long long _copied ;
+
+		public:
+			using Release = std::function<void(const void*, size_t)> ;
+			using Stamped = std::function<void(const Timestamp&)> ;
+
+		private:
+			size_t _reap(const Release& release, const Stamped* stamped) noexcept(false) ;
+
+		public:
+
+			/**
+			 * @brief ZeroCopySender (constructor) - enables SO_ZEROCOPY on a socket
+			 *
+			 * @param int sockfd - connected socket; not owned, so it must outlive this object
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			explicit ZeroCopySender(int sockfd) noexcept(false) ;
+
+			/**
+			 * @brief send - sends a buffer without copying it, tracking it until the kernel completes it
+			 * The sent bytes must stay untouched until reap() releases them
+			 *
+			 * @param const void* buf - buffer to send
+			 * @param size_t len - length of buffer
+			 * @param int flags - send flags; MSG_ZEROCOPY is added
+			 *
+			 * @return ssize_t - bytes sent, which may be fewer than len on a stream socket
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t send(const void* buf, size_t len, int flags) noexcept(false) ;
+
+			/**
+			 * @brief send (overload) - sends a buffer without copying it, tracking it until the kernel completes it
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK / ENOBUFS is routine rather than exceptional; std::bad_alloc may still propagate
+			 *
+			 * @param const void* buf - buffer to send
+			 * @param size_t len - length of buffer
+			 * @param int flags - send flags; MSG_ZEROCOPY is added
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return ssize_t - bytes sent, or -1 upon error
+			 */
+			ssize_t send(const void* buf, size_t len, int flags, std::error_code& ec) noexcept(false) ;
+
+			/**
+			 * @brief reap - drains completion notifications from the error queue without blocking
+			 * Buffers are released in the order the kernel completes them, each with the span covered by its send call
+			 *
+			 * @param const Release& release - called with each released span
+			 *
+			 * @return size_t - number of spans released
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t reap(const Release& release) noexcept(false) ;
+
+#ifdef SO_TIMESTAMPING
+			/**
+			 * @brief reap (overload) - drains completion notifications & TX timestamps from the error queue without blocking
+			 * For sockets which are also timestamped, where posicxx::tx_timestamps would throw completions away
+			 *
+			 * @param const Release& release - called with each released span
+			 * @param const Stamped& stamped - called with each TX timestamp, as posicxx::tx_timestamps would stash it
+			 *
+			 * @return size_t - number of spans released
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			size_t reap(const Release& release, const Stamped& stamped) noexcept(false) ;
+#endif // #ifdef SO_TIMESTAMPING
+
+			/**
+			 * @brief outstanding - returns the number of sent spans the kernel may still be reading from
+			 * Caller-owned buffers can only be freed once this reaches 0
+			 *
+			 * @return size_t - spans awaiting completion
+			 */
+			size_t outstanding() const noexcept ;
+
+			/**
+			 * @brief copied - returns the number of sends the kernel completed by copying after all
+			 * A steadily rising count (e.g. over loopback, or a device without scatter-gather) means plain posicxx::send would be cheaper
+			 *
+			 * @return unsigned long long - sends that fell back to copying
+			 */
+			unsigned long long copied() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			ZeroCopySender() noexcept = delete ;
+			ZeroCopySender(const ZeroCopySender& sender) noexcept = delete ;
+			ZeroCopySender& operator=(const ZeroCopySender& sender) noexcept = delete ;
+			ZeroCopySender(ZeroCopySender&& sender) noexcept = default ;
+			ZeroCopySender& operator=(ZeroCopySender&& sender) noexcept = default ;
+			~ZeroCopySender() noexcept = default ;
+	} ;
+
+#endif // #if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
+	/**
+	 * @brief cmsg_space - returns the bytes one control message with a given payload takes up, usable at compile time
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/sys/socket.h.html for CMSG_SPACE
+	 *
+	 * @param size_t len - length of payload
+	 *
+	 * @return size_t - length of header, payload & padding
+	 */
+	constexpr size_t cmsg_space(size_t len) noexcept
+	{
+		return CMSG_SPACE(len) ;
+	}
+
+	/**
+	 * @brief MessageBuilder (class) - message header over caller-sized storage for iovecs & control messages, reset & refilled for every posicxx::sendmsg / posicxx::recvmsg without allocation
+	 * Storage is supplied by posicxx::InlineMessage, which is what callers instantiate
+	 */
+	class MessageBuilder {
+		private:
+			struct msghdr _msg ;
+			struct iovec* _iov ;
+			size_t _iovcap ;
+			unsigned char* _control ;
+			size_t _controlcap ;
+			socklen_t _namecap ; // length given to name(), restored before each receive
+
+		protected:
+			/**
+			 * @brief MessageBuilder (constructor) - starts an empty message over inline storage
+			 *
+			 * @param struct iovec* iov - iovec storage, owned by the derived class
+			 * @param size_t iovcap - number of iovecs at `iov`
+			 * @param unsigned char* control - control message storage, aligned for struct cmsghdr & owned by the derived class
+			 * @param size_t controlcap - size of `control`
+			 */
+			MessageBuilder(struct iovec* iov, size_t iovcap, unsigned char* control, size_t controlcap) noexcept ;
+
+		public:
+			/**
+			 * @brief clear - empties the message, keeping its storage
+			 */
+			void clear() noexcept ;
+
+			/**
+			 * @brief name - sets the peer address: the destination when sending, where the source is stored when receiving
+			 * Every receive starts again from the full addrlen, so a short source address doesn't cap the next one
+			 *
+			 * @param void* addr - address, or nullptr for a connected socket
+			 * @param socklen_t addrlen - length of address, or room for it when receiving
+			 */
+			void name(void* addr, socklen_t addrlen) noexcept ;
+
+			/**
+			 * @brief append - adds a buffer: data to gather when sending, space to scatter into when receiving
+			 *
+			 * @param void* base - start of buffer
+			 * @param size_t len - length of buffer
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOBUFS when every iovec is in use)
+			 */
+			void append(void* base, size_t len) noexcept(false) ;
+
+			/**
+			 * @brief append (overload) - adds a buffer of data to gather when sending
+			 *
+			 * @param const void* base - start of buffer
+			 * @param size_t len - length of buffer
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOBUFS when every iovec is in use)
+			 */
+			void append(const void* base, size_t len) noexcept(false) ;
+
+			/**
+			 * @brief add_control - appends a control message to send
+			 *
+			 * @param int level - originating protocol, e.g. SOL_SOCKET
+			 * @param int type - protocol-specific type, e.g. SCM_RIGHTS
+			 * @param const void* data - payload
+			 * @param size_t len - length of payload
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOBUFS when the control storage is full)
+			 */
+			void add_control(int level, int type, const void* data, size_t len) noexcept(false) ;
+
+			/**
+			 * @brief add_control (overload) - appends a control message holding one object to send
+			 *
+			 * @param int level - originating protocol, e.g. SOL_SOCKET
+			 * @param int type - protocol-specific type
+			 * @param const T& value - payload, copied bytewise
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOBUFS when the control storage is full)
+			 */
+			template<typename T>
+			void add_control(int level, int type, const T& value) noexcept(false)
+			{
+				this->add_control(level, type, &value, sizeof(T)) ;
+			}
+
+			/**
+			 * @brief find_control - returns the first control message of a kind, after a receive
+			 *
+			 * @param int level - originating protocol
+			 * @param int type - protocol-specific type
+			 *
+			 * @return const struct cmsghdr* - matching control message, or nullptr if there is none
+			 */
+			const struct cmsghdr* find_control(int level, int type) const noexcept ;
+
+			/**
+			 * @brief first_control - returns the first control message, for walking all of them with next_control
+			 *
+			 * @return const struct cmsghdr* - first control message, or nullptr if there is none
+			 */
+			const struct cmsghdr* first_control() const noexcept ;
+
+			/**
+			 * @brief next_control - returns the control message following another
+			 *
+			 * @param const struct cmsghdr* cmsg - current control message
+			 *
+			 * @return const struct cmsghdr* - next control message, or nullptr if cmsg was the last
+			 */
+			const struct cmsghdr* next_control(const struct cmsghdr* cmsg) const noexcept ;
+
+			/**
+			 * @brief send - sends the message
+			 * A stub to posicxx::sendmsg - refer to it for more detail
+			 *
+			 * @param int sockfd - socket to send on
+			 * @param int flags - send flags
+			 *
+			 * @return ssize_t - bytes sent
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t send(int sockfd, int flags) noexcept(false) ;
+
+			/**
+			 * @brief send (overload) - sends the message
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param int sockfd - socket to send on
+			 * @param int flags - send flags
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return ssize_t - bytes sent, or -1 upon error
+			 */
+			ssize_t send(int sockfd, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief recv - receives into the appended buffers, with the whole control storage & the full address length given to name() open to the kernel
+			 * A stub to posicxx::recvmsg - refer to it for more detail
+			 *
+			 * @param int sockfd - socket to receive on
+			 * @param int flags - receive flags
+			 *
+			 * @return ssize_t - bytes received
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			ssize_t recv(int sockfd, int flags) noexcept(false) ;
+
+			/**
+			 * @brief recv (overload) - receives into the appended buffers, with the whole control storage & the full address length given to name() open to the kernel
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param int sockfd - socket to receive on
+			 * @param int flags - receive flags
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise
+			 *
+			 * @return ssize_t - bytes received, or -1 upon error
+			 */
+			ssize_t recv(int sockfd, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief flags - returns the flags the kernel set on the last received message, e.g. MSG_TRUNC, MSG_CTRUNC
+			 *
+			 * @return int - received flags
+			 */
+			int flags() const noexcept ;
+
+			/**
+			 * @brief get - returns the underlying message header, for calls the builder doesn't wrap
+			 *
+			 * @return struct msghdr* - message header
+			 */
+			struct msghdr* get() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			MessageBuilder() noexcept = delete ;
+			MessageBuilder(const MessageBuilder& builder) noexcept = delete ;
+			MessageBuilder& operator=(const MessageBuilder& builder) noexcept = delete ;
+			MessageBuilder(MessageBuilder&& builder) noexcept = delete ;
+			MessageBuilder& operator=(MessageBuilder&& builder) noexcept = delete ;
+			~MessageBuilder() noexcept = default ;
+	} ;
+
+	/**
+	 * @brief InlineMessage (class) - posicxx::MessageBuilder with room for Iovs iovecs & Control bytes of control messages inline
+	 * Size Control with posicxx::cmsg_space, summed over the control messages a single message carries
+	 */
+	template<size_t Iovs = 8, size_t Control = 0>
+	class InlineMessage : public MessageBuilder {
+		static_assert(Iovs > 0, "InlineMessage needs at least one iovec") ;
+
+		private:
+			struct iovec _iovs[Iovs] ;
+			alignas(struct cmsghdr) unsigned char _controls[Control == 0 ? 1 : Control] ;
+
+		public:
+			/**
+			 * @brief InlineMessage (constructor) - creates an empty message in inline storage
+			 */
+			InlineMessage() noexcept : MessageBuilder(this->_iovs, Iovs, this->_controls, Control)
+			{
+			}
+
+			/* Below are the defaulted and deleted methods */
+			InlineMessage(const InlineMessage& message) noexcept = delete ;
+			InlineMessage& operator=(const InlineMessage& message) noexcept = delete ;
+			InlineMessage(InlineMessage&& message) noexcept = delete ;
+			InlineMessage& operator=(InlineMessage&& message) noexcept = delete ;
+			~InlineMessage() noexcept = default ;
+	} ;
+
+	/**
+	 * @brief SendQueue (class) - outbound queue of caller-owned buffers for one nonblocking connection, written out with as few posicxx::sendmsg calls as possible
+	 * Buffers are referenced, not copied: each is handed back through its release callback once fully sent, & a partly sent one stays queued from where the kernel stopped
+	 * High / low watermarks on the queued bytes give hysteresis for backpressure, e.g. to stop reading from a peer while its responses pile up
+	 * Callbacks may throw: every buffer due is still released & the queue kept consistent before the first exception propagates
+	 * With posicxx::Reactor, register the socket for EPOLLIN | EPOLLOUT once & call flush() whenever EPOLLOUT is reported; being edge-triggered, that fires only when room opens up, so there is nothing to re-arm
+	 */
+	class SendQueue {
+		public:
+			/**
+			 * @brief Release - invoked with a buffer once all of it has been sent, or the queue is cleared
+			 */
+			using Release = std::function<void(const void* data, size_t len)> ;
+
+			/**
+			 * @brief Pressure - invoked with true when the queued bytes reach the high watermark, & with false when they fall back to the low one
+			 */
+			using Pressure = std::function<void(bool high)> ;
+
+		private:
+			struct Buffer {
+				const char* data ;
+				size_t size ;
+				Release release ;
+			} ;
+
+			int _fd ;
+			int _flags ;
+			size_t _low ;
+			size_t _high ;
+			size_t _queued ;
+			size_t _offset ; // bytes of the front buffer already sent
+			bool _pressured ;
+			std::deque<Buffer> _buffers ;
+			Pressure _pressure ;
+
+			void _consume(size_t sent) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief SendQueue (constructor) - creates an empty queue for a socket
+			 *
+			 * @param int sockfd - connected nonblocking socket; not owned, so it must outlive this object
+			 * @param size_t low - queued bytes at or below which pressure is relieved
+			 * @param size_t high - queued bytes at or above which pressure is signalled
+			 * @param Pressure pressure - called as the watermarks are crossed (may be empty)
+			 * @param int flags - send flags used for every write, e.g. MSG_NOSIGNAL
+			 */
+			SendQueue(int sockfd, size_t low, size_t high, Pressure pressure = Pressure(), int flags = 0) noexcept ;
+
+			/**
+			 * @brief push - queues a buffer behind the others, without sending it
+			 * The buffer must stay untouched until released
+			 *
+			 * @param const void* data - start of buffer
+			 * @param size_t len - length of buffer
+			 * @param Release release - called once the buffer is done with (may be empty)
+			 *
+			 * @return bool - whether the queue is below the high watermark, i.e. whether the caller may keep producing
+			 */
+			bool push(const void* data, size_t len, Release release = Release()) noexcept(false) ;
+
+			/**
+			 * @brief flush - sends queued buffers until the queue empties or the socket is full, gathering up to 64 of them per call
+			 *
+			 * @return size_t - bytes sent
+			 *
+			 * @throws posicxx::Error - exception thrown upon error other than EAGAIN / EWOULDBLOCK, or the first propagated from a callback
+			 */
+			size_t flush() noexcept(false) ;
+
+			/**
+			 * @brief flush (overload) - sends queued buffers until the queue empties or the socket is full
+			 * Socket errors are reported through ec instead of thrown; EAGAIN / EWOULDBLOCK only end the flush & don't set ec
+			 *
+			 * @param std::error_code& ec - cleared on success, set to the error (e.g. EPIPE) otherwise
+			 *
+			 * @return size_t - bytes sent before the error, if any
+			 *
+			 * @throws posicxx::Error - only the first exception propagated from a callback, once the buffers already sent are released
+			 */
+			size_t flush(std::error_code& ec) noexcept(false) ;
+
+			/**
+			 * @brief clear - drops every queued buffer, releasing each, e.g. when the connection is closed
+			 *
+			 * @throws posicxx::Error - only the first exception propagated from a callback, after every buffer has been released
+			 */
+			void clear() noexcept(false) ;
+
+			/**
+			 * @brief queued - returns the number of bytes awaiting sending
+			 *
+			 * @return size_t - unsent bytes across all buffers
+			 */
+			size_t queued() const noexcept ;
+
+			/**
+			 * @brief empty - returns whether nothing awaits sending
+			 *
+			 * @return bool - whether queued() is 0
+			 */
+			bool empty() const noexcept ;
+
+			/**
+			 * @brief pressured - returns whether the high watermark was reached & the low one hasn't been since
+			 *
+			 * @return bool - whether the caller should hold off producing
+			 */
+			bool pressured() const noexcept ;
+
+			/**
+			 * @brief SendQueue (destructor) - releases every buffer still queued, discarding exceptions from callbacks
+			 */
+			~SendQueue() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			SendQueue() noexcept = delete ;
+			SendQueue(const SendQueue& queue) noexcept = delete ;
+			SendQueue& operator=(const SendQueue& queue) noexcept = delete ;
+			SendQueue(SendQueue&& queue) noexcept = delete ;
+			SendQueue& operator=(SendQueue&& queue) noexcept = delete ;
+	} ;
+
+	/**
+	 * @brief SocketProfile (class) - batch of integer socket options (buffer sizes, flags, keepalive timings) built once & applied to every new socket in one call
+	 * Entries are type-checked against posicxx::SocketOption descriptors when added & kept inline, so applying a profile doesn't allocate
+	 */
+	class SocketProfile {
+		public:
+			static constexpr size_t capacity = 16 ;
+
+		private:
+			struct Entry {
+				int level ;
+				int name ;
+				int value ;
+			} ;
+
+			Entry _entries[capacity] ;
+			size_t _count ;
+
+			void _add(int level, int name, int value) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief SocketProfile (constructor) - creates an empty profile
+			 */
+			SocketProfile() noexcept ;
+
+			/**
+			 * @brief set - adds an option to the profile, replacing its earlier value if it was already added
+			 *
+			 * @tparam Option - posicxx::SocketOption descriptor whose type is int, e.g. posicxx::sockopt::sndbuf
+			 *
+			 * @param int value - value of the option
+			 *
+			 * @return SocketProfile& - reference to this profile, for chaining
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (ENOBUFS once capacity options were added)
+			 */
+			template<typename Option>
+			SocketProfile& set(int value) noexcept(false)
+			{
+				static_assert(std::is_same<typename Option::type, int>::value, "SocketProfile only holds int-valued options") ;
+				this->_add(Option::level, Option::name, value) ;
+				return *this ;
+			}
+
+			/**
+			 * @brief apply - sets every option of the profile on a socket, in the order they were added
+			 *
+			 * @param int sockfd - socket to configure
+			 *
+			 * @throws posicxx::Error - exception thrown upon the first error
+			 */
+			void apply(int sockfd) const noexcept(false) ;
+
+			/**
+			 * @brief apply (overload) - sets every option of the profile on a socket, in the order they were added
+			 * Non-throwing variant, stopping at the first error
+			 *
+			 * @param int sockfd - socket to configure
+			 * @param std::error_code& ec - cleared on success, set to the first error otherwise
+			 *
+			 * @return size_t - options set
+			 */
+			size_t apply(int sockfd, std::error_code& ec) const noexcept ;
+
+			/**
+			 * @brief size - returns the number of options in the profile
+			 *
+			 * @return size_t - options added
+			 */
+			size_t size() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			SocketProfile(const SocketProfile& profile) noexcept = default ;
+			SocketProfile& operator=(const SocketProfile& profile) noexcept = default ;
+			SocketProfile(SocketProfile&& profile) noexcept = default ;
+			SocketProfile& operator=(SocketProfile&& profile) noexcept = default ;
+			~SocketProfile() noexcept = default ;
+	} ;
+
+	/**
+	 * @brief FrameReader (class) - splits a byte stream into messages, either prefixed by their length (4 bytes, big-endian) or terminated by a delimiter
+	 * Receives straight into one buffer & yields frames as views into it, so no frame is copied; bytes are moved to the front only when a frame can't otherwise fit
+	 */
+	class FrameReader {
+		public:
+			enum class Format {
+				length_prefixed,
+				delimited
+			} ;
+
+			/**
+			 * @brief Frame (struct) - view of a complete frame's payload, valid until the next fill()
+			 */
+			struct Frame {
+				const char* data ;
+				size_t size ;
+			} ;
+
+		private:
+			std::unique_ptr<char[]> _buffer ;
+			size_t _capacity ;
+			size_t _head ; // start of the first unconsumed frame
+			size_t _tail ; // end of received bytes
+			size_t _scanned ; // delimited: bytes after _head already searched for the delimiter
+			size_t _need ; // bytes from _head the pending frame is known to span, or 0
+			Format _format ;
+			char _delimiter ;
+
+		public:
+			/**
+			 * @brief FrameReader (constructor) - allocates the receive buffer
+			 *
+			 * @param size_t capacity - size of buffer, which bounds the largest frame (including its prefix or delimiter)
+			 * @param Format format - how frames are delimited
+			 * @param char delimiter - terminator of each frame, for Format::delimited
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			FrameReader(size_t capacity, Format format, char delimiter = '\n') noexcept(false) ;
+
+			/**
+			 * @brief fill - receives as much as fits into the buffer
+			 * Invalidates frames returned by next(), which should be called until it returns false before filling again
+			 *
+			 * @param int sockfd - stream socket to receive from
+			 * @param int flags - receive flags
+			 *
+			 * @return ssize_t - bytes received; 0 once the peer has shut down
+			 *
+			 * @throws posicxx::Error - exception thrown upon error (EMSGSIZE for a frame larger than the buffer)
+			 */
+			ssize_t fill(int sockfd, int flags = 0) noexcept(false) ;
+
+			/**
+			 * @brief fill (overload) - receives as much as fits into the buffer
+			 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+			 *
+			 * @param int sockfd - stream socket to receive from
+			 * @param int flags - receive flags
+			 * @param std::error_code& ec - cleared on success, set to the error (EMSGSIZE for a frame larger than the buffer) otherwise
+			 *
+			 * @return ssize_t - bytes received, or -1 upon error
+			 */
+			ssize_t fill(int sockfd, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief next - takes the next complete frame out of the buffer
+			 *
+			 * @param Frame& frame - where the view of the payload is stashed
+			 *
+			 * @return bool - whether a complete frame was buffered
+			 */
+			bool next(Frame& frame) noexcept ;
+
+			/**
+			 * @brief buffered - returns the number of received bytes not yet taken as frames
+			 *
+			 * @return size_t - bytes of partial (or not yet taken) frames
+			 */
+			size_t buffered() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			FrameReader() noexcept = delete ;
+			FrameReader(const FrameReader& reader) noexcept = delete ;
+			FrameReader& operator=(const FrameReader& reader) noexcept = delete ;
+			FrameReader(FrameReader&& reader) noexcept = default ;
+			FrameReader& operator=(FrameReader&& reader) noexcept = default ;
+			~FrameReader() noexcept = default ;
+	} ;
+
+	/**
+	 * @brief FrameWriter (class) - frames messages for posicxx::FrameReader & sends a batch of them with one posicxx::sendmsg
+	 * Payloads are referenced, not copied, & must stay untouched until flushed; only the length prefixes live in the writer
+	 */
+	class FrameWriter {
+		public:
+			static constexpr size_t capacity = 32 ; // frames per batch
+
+		private:
+			struct iovec _iov[capacity * 2] ;
+			unsigned char _prefixes[capacity][4] ;
+			size_t _first ; // first iovec not fully sent
+			size_t _count ; // iovecs in use
+			size_t _pending ;
+			FrameReader::Format _format ;
+			char _delimiter ;
+
+		public:
+			/**
+			 * @brief FrameWriter (constructor) - creates an empty batch
+			 *
+			 * @param FrameReader::Format format - how frames are delimited
+			 * @param char delimiter - terminator of each frame, for Format::delimited; payloads mustn't contain it
+			 */
+			FrameWriter(FrameReader::Format format, char delimiter = '\n') noexcept ;
+
+			/**
+			 * @brief add - appends a frame to the batch
+			 *
+			 * @param const void* data - payload
+			 * @param size_t len - length of payload, at most UINT32_MAX for Format::length_prefixed
+			 *
+			 * @return bool - whether the frame was added; false when the batch is full & must be flushed first, or when len doesn't fit the length prefix
+			 */
+			bool add(const void* data, size_t len) noexcept ;
+
+			/**
+			 * @brief flush - sends the batch, continuing after short writes, until it is empty or the socket would block
+			 *
+			 * @param int sockfd - stream socket to send on
+			 * @param int flags - send flags
+			 *
+			 * @return size_t - bytes sent
+			 *
+			 * @throws posicxx::Error - exception thrown upon error, including EAGAIN if the batch couldn't be emptied
+			 */
+			size_t flush(int sockfd, int flags = 0) noexcept(false) ;
+
+			/**
+			 * @brief flush (overload) - sends the batch, continuing after short writes, until it is empty or the socket would block
+			 * Non-throwing variant for nonblocking sockets; whatever wasn't sent stays queued for the next flush
+			 *
+			 * @param int sockfd - stream socket to send on
+			 * @param int flags - send flags
+			 * @param std::error_code& ec - cleared once the batch is empty, set to the error (e.g. EAGAIN) otherwise
+			 *
+			 * @return size_t - bytes sent
+			 */
+			size_t flush(int sockfd, int flags, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief pending - returns the number of bytes, prefixes & delimiters included, awaiting sending
+			 *
+			 * @return size_t - unsent bytes
+			 */
+			size_t pending() const noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			FrameWriter() noexcept = delete ;
+			FrameWriter(const FrameWriter& writer) noexcept = delete ;
+			FrameWriter& operator=(const FrameWriter& writer) noexcept = delete ;
+			FrameWriter(FrameWriter&& writer) noexcept = delete ;
+			FrameWriter& operator=(FrameWriter&& writer) noexcept = delete ;
+			~FrameWriter() noexcept = default ;
+	} ;
+
+#ifdef SO_BUSY_POLL
+
+	/**
+	 * @brief set_busy_poll - makes blocking receives on a socket poll the device queue for a while before sleeping
+	 * Linux-specific. See https://man7.org/linux/man-pages/man7/socket.7.html for more details
+	 * Trades CPU for latency; raising usec above the system default (net.core.busy_read) may need CAP_NET_ADMIN
+	 *
+	 * @param int sockfd - socket to configure
+	 * @param unsigned usec - microseconds to busy poll for; 0 disables busy polling
+	 * @param bool prefer - whether busy polling should take precedence over interrupt-driven processing (SO_PREFER_BUSY_POLL), where supported; false leaves the socket's setting untouched
+	 * @param unsigned budget - packets processed per poll (SO_BUSY_POLL_BUDGET), where supported; 0 keeps the kernel default
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_busy_poll(int sockfd, unsigned usec, bool prefer = false, unsigned budget = 0) noexcept(false) ;
+
+#endif // #ifdef SO_BUSY_POLL
+
+	/**
+	 * @brief spin_recv - receives a message by retrying a nonblocking posicxx::recv instead of sleeping in the kernel
+	 * The thread never blocks, so no wakeup latency is paid when data arrives; it should own a core
+	 *
+	 * @param int sockfd - socket to receive on
+	 * @param void* buf - buffer to store message
+	 * @param size_t len - length of buffer
+	 * @param int flags - receive flags; MSG_DONTWAIT is added
+	 * @param unsigned long spins - attempts before giving up; 0 spins until data or an error arrives
+	 *
+	 * @return ssize_t - bytes received
+	 *
+	 * @throws posicxx::Error - exception thrown upon error, including EAGAIN once the attempts run out
+	 */
+	ssize_t spin_recv(int sockfd, void* buf, size_t len, int flags, unsigned long spins = 0) noexcept(false) ;
+
+	/**
+	 * @brief spin_recv (overload) - receives a message by retrying a nonblocking posicxx::recv instead of sleeping in the kernel
+	 * Non-throwing variant
+	 *
+	 * @param int sockfd - socket to receive on
+	 * @param void* buf - buffer to store message
+	 * @param size_t len - length of buffer
+	 * @param int flags - receive flags; MSG_DONTWAIT is added
+	 * @param unsigned long spins - attempts before giving up; 0 spins until data or an error arrives
+	 * @param std::error_code& ec - cleared on success, set to the error (EAGAIN once the attempts run out) otherwise
+	 *
+	 * @return ssize_t - bytes received, or -1 upon error
+	 */
+	ssize_t spin_recv(int sockfd, void* buf, size_t len, int flags, unsigned long spins, std::error_code& ec) noexcept ;
+
+#ifdef __linux__
+
+	constexpr size_t scm_max_fd = 253 ; // Linux's limit on descriptors carried by one SCM_RIGHTS message
+
+	/**
+	 * @brief send_fds - passes descriptors to the peer of a Unix domain socket, e.g. accepted connections handed from a master to a worker
+	 * Linux-specific. See https://man7.org/linux/man-pages/man7/unix.7.html for SCM_RIGHTS
+	 * Descriptors are packed posicxx::scm_max_fd to a message, each carrying one placeholder byte, & several messages go per posicxx::sendmmsg, so hundreds of descriptors take a single call
+	 * The caller keeps its own copies open & should close them once sent
+	 *
+	 * @param int sockfd - connected AF_UNIX socket
+	 * @param const int* fds - descriptors to pass
+	 * @param size_t count - number of descriptors
+	 * @param int flags - send flags
+	 *
+	 * @return size_t - number of descriptors sent, which may be fewer than count if the socket stopped accepting mid-way
+	 *
+	 * @throws posicxx::Error - exception thrown upon error, only when nothing was sent
+	 */
+	size_t send_fds(int sockfd, const int* fds, size_t count, int flags) noexcept(false) ;
+
+	/**
+	 * @brief send_fds (overload) - passes descriptors to the peer of a Unix domain socket
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connected AF_UNIX socket
+	 * @param const int* fds - descriptors to pass
+	 * @param size_t count - number of descriptors
+	 * @param int flags - send flags
+	 * @param std::error_code& ec - set to the error if nothing was sent, cleared otherwise
+	 *
+	 * @return size_t - number of descriptors sent
+	 */
+	size_t send_fds(int sockfd, const int* fds, size_t count, int flags, std::error_code& ec) noexcept ;
+
+	/**
+	 * @brief recv_fds - receives descriptors passed with posicxx::send_fds, already marked close-on-exec (MSG_CMSG_CLOEXEC)
+	 * Linux-specific. Waits for the first message only (MSG_WAITFORONE), then takes whatever else is queued, all in one posicxx::recvmmsg
+	 * Takes count / posicxx::scm_max_fd messages per call (at least one). Descriptors that arrive beyond count, or that the kernel had to drop, are reported as EMSGSIZE, so count should cover what the peer sends per message (posicxx::scm_max_fd covers any sender)
+	 *
+	 * @param int sockfd - connected AF_UNIX socket
+	 * @param int* fds - where to store the received descriptors
+	 * @param size_t count - room at fds
+	 * @param int flags - receive flags
+	 *
+	 * @return size_t - number of descriptors received; 0 once the peer has shut down
+	 *
+	 * @throws posicxx::Error - exception thrown upon error. EMSGSIZE if descriptors were lost, after closing those received
+	 */
+	size_t recv_fds(int sockfd, int* fds, size_t count, int flags) noexcept(false) ;
+
+	/**
+	 * @brief recv_fds (overload) - receives descriptors passed with posicxx::send_fds, already marked close-on-exec
+	 * Non-throwing variant for nonblocking sockets, where EAGAIN / EWOULDBLOCK is routine rather than exceptional
+	 *
+	 * @param int sockfd - connected AF_UNIX socket
+	 * @param int* fds - where to store the received descriptors
+	 * @param size_t count - room at fds
+	 * @param int flags - receive flags
+	 * @param std::error_code& ec - cleared on success, set to the error otherwise. EMSGSIZE if descriptors beyond count were closed or truncated by the kernel (MSG_CTRUNC); those stored at fds are still valid
+	 *
+	 * @return size_t - number of descriptors received
+	 */
+	size_t recv_fds(int sockfd, int* fds, size_t count, int flags, std::error_code& ec) noexcept ;
+
+#endif // #ifdef __linux__
+
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+
+	/* software RX & TX timestamps, TX ones keyed by a per-socket counter & reported without the payload */
+	constexpr unsigned timestamping_software = SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY ;
+
+	/**
+	 * @brief Timestamp (struct) - one kernel timestamp of a message, paired with when our code extracted it
+	 * Both are CLOCK_REALTIME. For RX, delay_ns() is how long the message sat between the kernel & the caller; for TX, it is only how long the stamp waited on the error queue
+	 * Send latency needs the caller's own send time, recorded under the same id (sends are numbered from 0 per socket under SOF_TIMESTAMPING_OPT_ID) & given to since_ns()
+	 */
+	struct Timestamp {
+		uint32_t id ; // TX: the send's number under SOF_TIMESTAMPING_OPT_ID, counting from 0 (bytes sent instead, on stream sockets); RX: 0
+		int type ; // TX: SCM_TSTAMP_SND / SCM_TSTAMP_SCHED / SCM_TSTAMP_ACK; RX: -1
+		struct timespec kernel ; // when the kernel received or transmitted (/ scheduled / had acknowledged) the message
+		struct timespec extracted ; // when rx_timestamp / tx_timestamps extracted the stamp
+
+		/**
+		 * @brief delay_ns - returns the time from the kernel's timestamp to its extraction
+		 *
+		 * @return int64_t - nanoseconds
+		 */
+		int64_t delay_ns() const noexcept ;
+
+		/**
+		 * @brief since_ns - returns the time from a caller-recorded instant to the kernel's timestamp, e.g. from just before the send numbered id to its SCM_TSTAMP_SND
+		 *
+		 * @param const struct timespec& sent - CLOCK_REALTIME instant recorded by the caller
+		 *
+		 * @return int64_t - nanoseconds
+		 */
+		int64_t since_ns(const struct timespec& sent) const noexcept ;
+	} ;
+
+	/**
+	 * @brief set_timestamping - enables kernel timestamping of a socket's messages
+	 * Linux-specific. See https://www.kernel.org/doc/html/latest/networking/timestamping.html for more details
+	 *
+	 * @param int sockfd - socket to timestamp
+	 * @param unsigned flags - SOF_TIMESTAMPING_* flags OR'd together, e.g. posicxx::timestamping_software; 0 disables timestamping
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void set_timestamping(int sockfd, unsigned flags) noexcept(false) ;
+
+	/**
+	 * @brief rx_timestamp - extracts the receive timestamp from a message received with posicxx::recvmsg (or posicxx::MessageBuilder::recv)
+	 * The message needs posicxx::cmsg_space(sizeof(struct timespec) * 3) bytes of control storage
+	 *
+	 * @param const struct msghdr* msg - received message
+	 * @param Timestamp* stamp - where the timestamp is stashed
+	 *
+	 * @return bool - whether the message carried a timestamp
+	 */
+	bool rx_timestamp(const struct msghdr* msg, Timestamp* stamp) noexcept ;
+
+	/**
+	 * @brief tx_timestamps - drains transmit timestamps from the socket's error queue without blocking
+	 * The error queue signals readiness with EPOLLERR. Other notifications on it are discarded, so a socket also sending with posicxx::ZeroCopySender must be drained with its reap(release, stamped) instead
+	 *
+	 * @param int sockfd - socket with TX timestamping enabled
+	 * @param Timestamp* stamps - where the timestamps are stashed
+	 * @param size_t count - room at stamps
+	 *
+	 * @return size_t - number of timestamps stashed
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	size_t tx_timestamps(int sockfd, Timestamp* stamps, size_t count) noexcept(false) ;
+
+#endif // #if defined(__linux__) && defined(SO_TIMESTAMPING)
+
 }
 
 #endif // #ifndef POSICXX_SYS_SOCKET_HH
@@ -0,0 +1,220 @@
+#ifndef POSICXX_SYS_UN_HH
+#define POSICXX_SYS_UN_HH
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <system_error>
+
+#include "sys/socket.hh"
+
+/**
+ * @brief sys/un.hh - file serves as CXX declarations of POSIX Unix domain socket functionality, containing the minimal wrapper & fancy interface
+ * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/sys/un.h.html for general details
+ */
+
+namespace posicxx {
+
+	/**
+	 * @brief unix_address - fills in a Unix domain socket address, for posicxx::bind / posicxx::connect
+	 * A name starting with '@' is placed in Linux's abstract namespace (as shown by ss), which needs no file & vanishes with its last socket
+	 *
+	 * @param const char* name - filesystem path, or '@' followed by an abstract name
+	 * @param struct sockaddr_un* addr - address to fill in
+	 *
+	 * @return socklen_t - length of the address, to pass alongside it
+	 *
+	 * @throws posicxx::Error - exception thrown upon error. EINVAL for an empty name, ENAMETOOLONG if it doesn't fit sun_path
+	 */
+	socklen_t unix_address(const char* name, struct sockaddr_un* addr) noexcept(false) ;
+
+#if defined(__linux__) && defined(SO_PEERCRED)
+
+	namespace sockopt {
+
+		using peercred = SocketOption<SOL_SOCKET, SO_PEERCRED, struct ucred> ;
+
+	}
+
+	/**
+	 * @brief BusListener (class) - listening end of a local message bus, over AF_UNIX SOCK_SEQPACKET
+	 * Linux-specific. Each accepted connection carries whole messages: one send is one receive, so no framing is needed. Peers are admitted only if their credentials (taken by the kernel at connect time) pass the authorization check
+	 */
+	class BusListener {
+		public:
+			/**
+			 * @brief Authorize - decides whether a connecting peer is admitted, given its pid, uid & gid
+			 */
+			using Authorize = std::function<bool(const struct ucred& peer)> ;
+
+		private:
+			int _fd ;
+			std::string _path ; // filesystem path to unlink on destruction, empty for abstract addresses
+			Authorize _authorize ;
+			size_t _rejected ;
+
+		public:
+			/**
+			 * @brief BusListener (constructor) - creates a nonblocking listening socket bound to name
+			 *
+			 * @param const char* name - address, as for posicxx::unix_address
+			 * @param Authorize authorize - admission check. Defaults to admitting only peers running as this process's effective uid
+			 * @param int backlog - queue length of pending connections
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			BusListener(const char* name, Authorize authorize = nullptr, int backlog = SOMAXCONN) noexcept(false) ;
+
+			/**
+			 * @brief fd - returns the listening socket, e.g. to register with a posicxx::Reactor for EPOLLIN
+			 *
+			 * @return int - listening socket
+			 */
+			int fd() const noexcept ;
+
+			/**
+			 * @brief accept - accepts the next admitted connection, closing any rejected ones queued before it
+			 *
+			 * @param struct ucred* peer - receives the peer's credentials, may be nullptr
+			 *
+			 * @return int - nonblocking, close-on-exec connection owned by the caller (e.g. handed to posicxx::BusChannel), or -1 when none are pending
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			int accept(struct ucred* peer = nullptr) noexcept(false) ;
+
+			/**
+			 * @brief rejected - returns the number of connections closed by the authorization check
+			 *
+			 * @return size_t - rejected connections
+			 */
+			size_t rejected() const noexcept ;
+
+			/**
+			 * @brief BusListener (destructor) - closes the socket & unlinks a filesystem address
+			 */
+			~BusListener() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			BusListener() noexcept = delete ;
+			BusListener(const BusListener& listener) noexcept = delete ;
+			BusListener& operator=(const BusListener& listener) noexcept = delete ;
+			BusListener(BusListener&& listener) noexcept = delete ;
+			BusListener& operator=(BusListener&& listener) noexcept = delete ;
+	} ;
+
+	/**
+	 * @brief BusChannel (class) - one connection of a local message bus, over AF_UNIX SOCK_SEQPACKET
+	 * Linux-specific. Messages keep their boundaries & arrive whole, in order; several can go out in one sendmmsg. For receiving many per call, posicxx::DatagramBatch works on fd() as it does on a datagram socket
+	 * Zero-length messages are rejected, since they can't be told apart from the peer closing
+	 */
+	class BusChannel {
+		private:
+			int _fd ;
+
+		public:
+			/**
+			 * @brief BusChannel (constructor) - takes ownership of a connected SOCK_SEQPACKET socket, e.g. from posicxx::BusListener::accept
+			 *
+			 * @param int fd - connected socket
+			 */
+			explicit BusChannel(int fd) noexcept ;
+
+			/**
+			 * @brief connect - connects to a posicxx::BusListener, checking the listener's credentials
+			 *
+			 * @param const char* name - address, as for posicxx::unix_address
+			 * @param BusListener::Authorize authorize - check of the listener's credentials. Defaults to requiring this process's effective uid
+			 *
+			 * @return BusChannel - nonblocking, close-on-exec connection
+			 *
+			 * @throws posicxx::Error - exception thrown upon error. EACCES if the listener fails the check
+			 */
+			static BusChannel connect(const char* name, BusListener::Authorize authorize = nullptr) noexcept(false) ;
+
+			/**
+			 * @brief fd - returns the connection, e.g. to register with a posicxx::Reactor
+			 *
+			 * @return int - connected socket
+			 */
+			int fd() const noexcept ;
+
+			/**
+			 * @brief peer - returns the credentials the peer had when the connection was made
+			 *
+			 * @return struct ucred - pid, uid & gid of the peer
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			struct ucred peer() const noexcept(false) ;
+
+			/**
+			 * @brief send - sends one message
+			 *
+			 * @param const void* data - message
+			 * @param size_t len - bytes of message, non-zero & within the socket's send buffer
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise (e.g. EAGAIN while the peer is behind)
+			 *
+			 * @return bool - whether the message was sent
+			 */
+			bool send(const void* data, size_t len, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief send (overload) - sends several messages with one sendmmsg, each as a separate message
+			 *
+			 * @param const struct iovec* messages - one buffer per message, each non-zero in length
+			 * @param size_t count - number of messages
+			 * @param std::error_code& ec - cleared unless an error stopped the batch before its end, set to the error otherwise
+			 *
+			 * @return size_t - number of messages sent from the front of `messages`, to resume from
+			 */
+			size_t send(const struct iovec* messages, size_t count, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief recv - receives one whole message
+			 *
+			 * @param void* buf - destination
+			 * @param size_t len - bytes available at buf
+			 * @param std::error_code& ec - cleared on success, set to the error otherwise (EAGAIN if none are pending, EMSGSIZE if the message was larger than len & has been discarded)
+			 *
+			 * @return size_t - bytes of message, or 0 if the peer closed or upon error
+			 */
+			size_t recv(void* buf, size_t len, std::error_code& ec) noexcept ;
+
+			/**
+			 * @brief BusChannel (move constructor) - acquires an existing connection
+			 *
+			 * @param BusChannel&& channel - channel to acquire
+			 */
+			BusChannel(BusChannel&& channel) noexcept ;
+
+			/**
+			 * @brief operator= (move assignment) - closes this connection & acquires an existing one
+			 *
+			 * @param BusChannel&& channel - channel to acquire
+			 *
+			 * @return BusChannel& - reference to this channel
+			 */
+			BusChannel& operator=(BusChannel&& channel) noexcept ;
+
+			/**
+			 * @brief BusChannel (destructor) - closes the connection
+			 */
+			~BusChannel() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			BusChannel() noexcept = delete ;
+			BusChannel(const BusChannel& channel) noexcept = delete ;
+			BusChannel& operator=(const BusChannel& channel) noexcept = delete ;
+	} ;
+
+#endif // #if defined(__linux__) && defined(SO_PEERCRED)
+
+}
+
+#endif // #ifndef POSICXX_SYS_UN_HH
@@ -4,6 +4,8 @@
 
 #include <unistd.h>
 
+#include <cstddef>
+
 /**
  * @brief unistd.hh - file serves as CXX declarations of POSIX miscellaneous functionality, containing the minimal wrapper, fancy interface and resource manager
  * See https://pubs.opengroup.org/onlinepubs/009695399/basedefs/sys/unistd.h.html for general details
@@ -11,6 +13,8 @@
 
 namespace posicxx {
 
+	class StringBuffer ;
+
 	/**
 	 * @brief access - determine accessibility of a file
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/access.html for more details
@@ -127,6 +131,24 @@ namespace posicxx {
 	 */
 	int dup2(int fildes, int fildes2) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief dup3 - duplicates an open file descriptor, with flags set atomically upon creation
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/dup3.2.html for more details
+	 *
+	 * @param int fildes - file descriptor to create alternate descriptor for
+	 * @param int fildes2 - file descriptor to be overwritten and set to be used as file behind fildes argument; must differ from fildes
+	 * @param int flags - 0 or O_CLOEXEC
+	 *
+	 * @return int - created file descriptor
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	int dup3(int fildes, int fildes2, int flags) noexcept(false) ;
+
+#endif // #ifdef __linux__
+
 	/**
 	 * @brief encrypt - encodes using an implementation-defined encoding algorithm
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/encrypt.html for more details
@@ -331,6 +353,17 @@ namespace posicxx {
 	 */
 	void getcwd(char* buf, size_t size) noexcept(false) ;
 
+	/**
+	 * @brief getcwd (overload) - gets the pathname of the current working directory
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getcwd.html for more details
+	 * Grows `buf` geometrically while the result doesn't fit, so no allocation takes place unless the result outgrows the buffer's inline storage
+	 *
+	 * @param StringBuffer& buf - string to stash name of working directory in (e.g. a posicxx::InlineString)
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void getcwd(StringBuffer& buf) noexcept(false) ;
+
 	/**
 	 * @brief getegid - gets the effective group ID
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getegid.html for more details
@@ -387,6 +420,17 @@ namespace posicxx {
 	 */
 	void gethostname(char* name, size_t namelen) noexcept(false) ;
 
+	/**
+	 * @brief gethostname (overload) - gets name of the current host
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/gethostname.html for more details
+	 * Grows `buf` geometrically while the result doesn't fit, so no allocation takes place unless the result outgrows the buffer's inline storage
+	 *
+	 * @param StringBuffer& name - string to stash host name in
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void gethostname(StringBuffer& name) noexcept(false) ;
+
 	/**
 	 * @brief getlogin - gets login name
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getlogin.html for more details
@@ -408,6 +452,17 @@ namespace posicxx {
 	 */
 	void getlogin_r(char* name, size_t namesize) noexcept(false) ;
 
+	/**
+	 * @brief getlogin_r (overload) - gets login name
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getlogin_r.html for more details
+	 * Grows `buf` geometrically while the result doesn't fit, so no allocation takes place unless the result outgrows the buffer's inline storage
+	 *
+	 * @param StringBuffer& name - string to stash login name in
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void getlogin_r(StringBuffer& name) noexcept(false) ;
+
 	/**
 	 * @brief getopt - command option parsing
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getopt.html for more details
@@ -487,6 +542,17 @@ namespace posicxx {
 	 */
 	void getwd(char* path_name) noexcept(false) ;
 
+	/**
+	 * @brief getwd (overload) - gets the current working directory pathname
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/getwd.html for more details
+	 * Note: getwd() itself needs a PATH_MAX sized buffer, so this is a stub to posicxx::getcwd(StringBuffer&) - refer to it for more detail
+	 *
+	 * @param StringBuffer& path_name - string to stash name of working directory in
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void getwd(StringBuffer& path_name) noexcept(false) ;
+
 	/**
 	 * @brief isatty - tests for a terminal device
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/isatty.html for more details
@@ -593,6 +659,21 @@ namespace posicxx {
 	 */
 	void pipe(int fildes[2]) noexcept(false) ;
 
+#ifdef __linux__
+
+	/**
+	 * @brief pipe2 - create an interprocess channel, with flags set atomically upon creation
+	 * Linux-specific. See https://man7.org/linux/man-pages/man2/pipe2.2.html for more details
+	 *
+	 * @param int fildes[2] - array capable of storing 2+ integers to stash created file descriptors each for a respective end of the pipe
+	 * @param int flags - 0 or any of O_CLOEXEC, O_DIRECT (packet mode), O_NONBLOCK OR'd together
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void pipe2(int fildes[2], int flags) noexcept(false) ;
+
+#endif // #ifdef __linux__
+
 	/**
 	 * @brief pread - read from a seekable file from a given position in the file without changing the file pointer
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/pread.html for more details
@@ -651,6 +732,21 @@ namespace posicxx {
 	 */
 	ssize_t readlink(const char* path, char* buf, size_t bufsize) noexcept(false) ;
 
+	/**
+	 * @brief readlink (overload) - reads the contents of a symbolic link
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/readlink.html for more details
+	 * Grows `buf` geometrically while the result doesn't fit, so no allocation takes place unless the result outgrows the buffer's inline storage
+	 * The result is null-terminated, unlike that of the raw call
+	 *
+	 * @param const char* path - path to symbolic link
+	 * @param StringBuffer& buf - string to stash contents of the link in
+	 *
+	 * @return ssize_t - number of bytes placed in the buffer (excluding the null terminator)
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	ssize_t readlink(const char* path, StringBuffer& buf) noexcept(false) ;
+
 	/**
 	 * @brief rmdir - removes a directory
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/rmdir.html for more details
@@ -859,6 +955,18 @@ namespace posicxx {
 	 */
 	void ttyname_r(int fildes, char* name, size_t namesize) noexcept(false) ;
 
+	/**
+	 * @brief ttyname_r (overload) - find the pathname of a terminal
+	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/ttyname_r.html for more details
+	 * Grows `buf` geometrically while the result doesn't fit, so no allocation takes place unless the result outgrows the buffer's inline storage
+	 *
+	 * @param int fildes - open file descriptor to terminal
+	 * @param StringBuffer& name - string to stash terminal's pathname in
+	 *
+	 * @throws posicxx::Error - exception thrown upon error
+	 */
+	void ttyname_r(int fildes, StringBuffer& name) noexcept(false) ;
+
 	/**
 	 * @brief ualarm - set the interval timer
 	 * See https://pubs.opengroup.org/onlinepubs/009695399/functions/ualarm.html for more details
@@ -914,6 +1022,214 @@ namespace posicxx {
 	 */
 	ssize_t write(int fildes, const void* buf, size_t nbyte) noexcept(false) ;
 
+	/**
+	 * @brief StringBuffer (class) - null-terminated character buffer which starts out in storage provided by a derived class & moves to the heap only when grown past it
+	 * The capacity accounts for the null terminator, so it may be handed as-is to calls taking a (buffer, size) pair
+	 * Not to be instantiated directly - see posicxx::InlineString
+	 */
+	class StringBuffer {
+		private:
+			char* _data ; // current storage, either _inline or heap-allocated
+			size_t _size ; // length of string, excluding the null terminator
+			size_t _capacity ; // bytes available at _data, including the null terminator
+			char* const _inline ; // inline storage owned by the derived class
+			const size_t _inline_capacity ;
+
+		protected:
+			/**
+			 * @brief StringBuffer (constructor) - starts an empty string in inline storage
+			 *
+			 * @param char* storage - inline storage, owned by the derived class
+			 * @param size_t capacity - size of `storage`. Must be at least 1
+			 */
+			StringBuffer(char* storage, size_t capacity) noexcept ;
+
+			/**
+			 * @brief _acquire - takes the contents of another buffer, stealing its heap storage rather than copying if it has any
+			 *
+			 * @param StringBuffer& other - buffer to take from. Left empty
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void _acquire(StringBuffer& other) noexcept(false) ;
+
+		public:
+			/**
+			 * @brief data - returns the underlying storage, writable up to capacity() bytes
+			 *
+			 * @return char* - start of storage
+			 */
+			char* data() noexcept ;
+
+			/**
+			 * @brief data - returns the underlying storage
+			 *
+			 * @return const char* - start of storage
+			 */
+			const char* data() const noexcept ;
+
+			/**
+			 * @brief c_str - returns the null-terminated string
+			 *
+			 * @return const char* - start of the string
+			 */
+			const char* c_str() const noexcept ;
+
+			/**
+			 * @brief size - returns the length of the string
+			 *
+			 * @return size_t - length, excluding the null terminator
+			 */
+			size_t size() const noexcept ;
+
+			/**
+			 * @brief capacity - returns the number of bytes of storage
+			 *
+			 * @return size_t - bytes available at data(), including room for the null terminator
+			 */
+			size_t capacity() const noexcept ;
+
+			/**
+			 * @brief empty - returns whether the string has no characters
+			 *
+			 * @return bool - whether size() is 0
+			 */
+			bool empty() const noexcept ;
+
+			/**
+			 * @brief inlined - returns whether the string still lives in its inline storage
+			 *
+			 * @return bool - whether no heap allocation is held
+			 */
+			bool inlined() const noexcept ;
+
+			/**
+			 * @brief reserve - ensures storage of at least the given number of bytes, preserving the string
+			 *
+			 * @param size_t capacity - bytes of storage wanted, including room for the null terminator
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void reserve(size_t capacity) noexcept(false) ;
+
+			/**
+			 * @brief resize - sets the length of the string after its storage was written to directly, & null-terminates it
+			 *
+			 * @param size_t size - new length. Must be less than capacity()
+			 */
+			void resize(size_t size) noexcept ;
+
+			/**
+			 * @brief assign - replaces the string with a copy of some characters
+			 *
+			 * @param const char* str - characters to copy
+			 * @param size_t len - number of characters to copy
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			void assign(const char* str, size_t len) noexcept(false) ;
+
+			/**
+			 * @brief clear - empties the string, keeping its storage
+			 */
+			void clear() noexcept ;
+
+			/**
+			 * @brief StringBuffer (destructor) - releases any heap storage
+			 */
+			~StringBuffer() noexcept ;
+
+			/* Below are the defaulted and deleted methods */
+			StringBuffer() noexcept = delete ;
+			StringBuffer(const StringBuffer& buffer) noexcept = delete ;
+			StringBuffer& operator=(const StringBuffer& buffer) noexcept = delete ;
+			StringBuffer(StringBuffer&& buffer) noexcept = delete ;
+			StringBuffer& operator=(StringBuffer&& buffer) noexcept = delete ;
+	} ;
+
+	/**
+	 * @brief InlineString (class) - posicxx::StringBuffer with N bytes of inline storage
+	 * The default size suits typical paths & names, so the StringBuffer overloads (e.g. posicxx::getcwd) usually don't touch the heap
+	 */
+	template<size_t N = 256>
+	class InlineString : public StringBuffer {
+		static_assert(N > 0, "InlineString needs room for at least the null terminator") ;
+
+		private:
+			char _storage[N] ;
+
+		public:
+			/**
+			 * @brief InlineString (constructor) - creates an empty string in inline storage
+			 */
+			InlineString() noexcept : StringBuffer(this->_storage, N)
+			{
+			}
+
+			/**
+			 * @brief InlineString (copy constructor) - copies a string
+			 *
+			 * @param const InlineString& str - string to copy
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			InlineString(const InlineString& str) noexcept(false) : InlineString()
+			{
+				this->assign(str.data(), str.size()) ;
+			}
+
+			/**
+			 * @brief InlineString (move constructor) - acquires a string, stealing its heap storage if it has any
+			 *
+			 * @param InlineString&& str - string to acquire
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			InlineString(InlineString&& str) noexcept(false) : InlineString()
+			{
+				this->_acquire(str) ;
+			}
+
+			/**
+			 * @brief operator= (copy assignment) - copies a string
+			 *
+			 * @param const InlineString& str - string to copy
+			 *
+			 * @return InlineString& - reference to this string
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			InlineString& operator=(const InlineString& str) noexcept(false)
+			{
+				if(this != &str)
+				{
+					this->assign(str.data(), str.size()) ;
+				}
+				return *this ;
+			}
+
+			/**
+			 * @brief operator= (move assignment) - acquires a string, stealing its heap storage if it has any
+			 *
+			 * @param InlineString&& str - string to acquire
+			 *
+			 * @return InlineString& - reference to this string
+			 *
+			 * @throws posicxx::Error - exception thrown upon error
+			 */
+			InlineString& operator=(InlineString&& str) noexcept(false)
+			{
+				if(this != &str)
+				{
+					this->_acquire(str) ;
+				}
+				return *this ;
+			}
+
+			/* Below are the defaulted and deleted methods */
+			~InlineString() noexcept = default ;
+	} ;
+
 }
 
 #endif // #ifndef POSICXX_UNISTD_HH
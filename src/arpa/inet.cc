@@ -0,0 +1,334 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+#include <cstdint>
+#include <cstring>
+
+#include "arpa/inet.hh"
+
+/**
+ * @brief arpa/inet.cc - file serves as CXX definitions of POSIX internet operations, containing the minimal wrapper
+ */
+
+namespace {
+
+	/* hex digit value of a character, or -1 */
+	inline int hex_value(const char ch) noexcept
+	{
+		if(ch >= '0' && ch <= '9')
+		{
+			return ch - '0' ;
+		}
+		const char lower = static_cast<char>(ch | 0x20) ;
+		if(lower >= 'a' && lower <= 'f')
+		{
+			return lower - 'a' + 10 ;
+		}
+		return -1 ;
+	}
+
+	bool pton4(const char* src, const char* end, unsigned char* dst) noexcept
+	{
+		unsigned char out[4] = {0, 0, 0, 0} ;
+		unsigned octets = 0 ;
+		unsigned value = 0 ;
+		bool digits = false ;
+
+		for( ; src < end ; ++src)
+		{
+			const unsigned digit = static_cast<unsigned char>(*src) - static_cast<unsigned>('0') ;
+			if(digit < 10)
+			{
+				if(digits && value == 0)
+				{
+					return false ; // leading zero
+				}
+				value = value * 10 + digit ;
+				if(value > 255)
+				{
+					return false ;
+				}
+				if(!digits)
+				{
+					if(++octets > 4)
+					{
+						return false ;
+					}
+					digits = true ;
+				}
+			}
+			else if(*src == '.' && digits)
+			{
+				if(octets == 4)
+				{
+					return false ;
+				}
+				out[octets - 1] = static_cast<unsigned char>(value) ;
+				value = 0 ;
+				digits = false ;
+			}
+			else
+			{
+				return false ;
+			}
+		}
+
+		if(octets < 4 || !digits)
+		{
+			return false ;
+		}
+		out[3] = static_cast<unsigned char>(value) ;
+		std::memcpy(dst, out, sizeof(out)) ;
+		return true ;
+	}
+
+	bool pton6(const char* src, const char* end, unsigned char* dst) noexcept
+	{
+		unsigned char out[16] ;
+		std::memset(out, 0, sizeof(out)) ;
+		unsigned char* tp = out ;
+		unsigned char* const endp = out + sizeof(out) ;
+		unsigned char* colonp = nullptr ;
+
+		if(src == end)
+		{
+			return false ;
+		}
+		if(*src == ':')
+		{
+			/* a leading colon is only valid as part of "::" */
+			if(++src == end || *src != ':')
+			{
+				return false ;
+			}
+		}
+
+		const char* token = src ;
+		unsigned seen = 0 ;
+		unsigned value = 0 ;
+		while(src < end)
+		{
+			const char ch = *src++ ;
+			const int digit = hex_value(ch) ;
+			if(digit >= 0)
+			{
+				if(seen == 4)
+				{
+					return false ;
+				}
+				value = value << 4 | static_cast<unsigned>(digit) ;
+				++seen ;
+				continue ;
+			}
+			if(ch == ':')
+			{
+				token = src ;
+				if(seen == 0)
+				{
+					if(colonp != nullptr)
+					{
+						return false ;
+					}
+					colonp = tp ;
+					continue ;
+				}
+				if(src == end || tp + 2 > endp)
+				{
+					return false ;
+				}
+				*tp++ = static_cast<unsigned char>(value >> 8) ;
+				*tp++ = static_cast<unsigned char>(value) ;
+				seen = 0 ;
+				value = 0 ;
+				continue ;
+			}
+			if(ch == '.' && tp + 4 <= endp && pton4(token, end, tp))
+			{
+				tp += 4 ;
+				seen = 0 ;
+				break ;
+			}
+			return false ;
+		}
+
+		if(seen > 0)
+		{
+			if(tp + 2 > endp)
+			{
+				return false ;
+			}
+			*tp++ = static_cast<unsigned char>(value >> 8) ;
+			*tp++ = static_cast<unsigned char>(value) ;
+		}
+		if(colonp != nullptr)
+		{
+			/* "::" must stand for at least one zero group */
+			if(tp == endp)
+			{
+				return false ;
+			}
+			const size_t n = static_cast<size_t>(tp - colonp) ;
+			std::memmove(endp - n, colonp, n) ;
+			std::memset(colonp, 0, static_cast<size_t>(endp - n - colonp)) ;
+			tp = endp ;
+		}
+		if(tp != endp)
+		{
+			return false ;
+		}
+
+		std::memcpy(dst, out, sizeof(out)) ;
+		return true ;
+	}
+
+	/* writes a byte in decimal, returning the end of the text */
+	inline char* put_decimal(char* tp, const unsigned value) noexcept
+	{
+		if(value >= 100)
+		{
+			*tp++ = static_cast<char>('0' + value / 100) ;
+		}
+		if(value >= 10)
+		{
+			*tp++ = static_cast<char>('0' + value / 10 % 10) ;
+		}
+		*tp++ = static_cast<char>('0' + value % 10) ;
+		return tp ;
+	}
+
+	char* ntop4(const unsigned char* src, char* tp) noexcept
+	{
+		tp = put_decimal(tp, src[0]) ;
+		*tp++ = '.' ;
+		tp = put_decimal(tp, src[1]) ;
+		*tp++ = '.' ;
+		tp = put_decimal(tp, src[2]) ;
+		*tp++ = '.' ;
+		return put_decimal(tp, src[3]) ;
+	}
+
+	char* ntop6(const unsigned char* src, char* tp) noexcept
+	{
+		static const char hex[] = "0123456789abcdef" ;
+
+		unsigned words[8] ;
+		for(int i = 0 ; i < 8 ; ++i)
+		{
+			words[i] = static_cast<unsigned>(src[2 * i]) << 8 | src[2 * i + 1] ;
+		}
+
+		/* the first longest run of zero groups, if 2+ long, becomes "::" */
+		int best = -1 ;
+		int best_len = 0 ;
+		for(int i = 0 ; i < 8 ; )
+		{
+			if(words[i] != 0)
+			{
+				++i ;
+				continue ;
+			}
+			int j = i ;
+			while(j < 8 && words[j] == 0)
+			{
+				++j ;
+			}
+			if(j - i > best_len)
+			{
+				best = i ;
+				best_len = j - i ;
+			}
+			i = j ;
+		}
+		if(best_len < 2)
+		{
+			best = -1 ;
+		}
+
+		for(int i = 0 ; i < 8 ; ++i)
+		{
+			if(best != -1 && i >= best && i < best + best_len)
+			{
+				if(i == best)
+				{
+					*tp++ = ':' ;
+				}
+				continue ;
+			}
+			if(i != 0)
+			{
+				*tp++ = ':' ;
+			}
+			if(i == 6 && best == 0 && (best_len == 6 || (best_len == 5 && words[5] == 0xffff)))
+			{
+				return ntop4(src + 12, tp) ;
+			}
+
+			const unsigned word = words[i] ;
+			if(word >= 0x1000)
+			{
+				*tp++ = hex[word >> 12] ;
+			}
+			if(word >= 0x100)
+			{
+				*tp++ = hex[word >> 8 & 0xf] ;
+			}
+			if(word >= 0x10)
+			{
+				*tp++ = hex[word >> 4 & 0xf] ;
+			}
+			*tp++ = hex[word & 0xf] ;
+		}
+		if(best != -1 && best + best_len == 8)
+		{
+			*tp++ = ':' ;
+		}
+		return tp ;
+	}
+
+}
+
+const char* posicxx::inet_ntop(int af, const void* src, char* dst, socklen_t size) noexcept(false)
+{
+	char text[INET6_ADDRSTRLEN] ;
+	char* end ;
+
+	if(af == AF_INET)
+	{
+		end = ntop4(static_cast<const unsigned char*>(src), text) ;
+	}
+	else if(af == AF_INET6)
+	{
+		end = ntop6(static_cast<const unsigned char*>(src), text) ;
+	}
+	else
+	{
+		throw std::system_error(EAFNOSUPPORT, std::generic_category()) ;
+	}
+
+	const size_t len = static_cast<size_t>(end - text) ;
+	if(len >= size)
+	{
+		throw std::system_error(ENOSPC, std::generic_category()) ;
+	}
+	std::memcpy(dst, text, len) ;
+	dst[len] = '\0' ;
+	return dst ;
+}
+
+bool posicxx::inet_pton(int af, const char* src, void* dst) noexcept(false)
+{
+	return posicxx::inet_pton(af, src, std::strlen(src), dst) ;
+}
+
+bool posicxx::inet_pton(int af, const char* src, size_t len, void* dst) noexcept(false)
+{
+	if(af == AF_INET)
+	{
+		return pton4(src, src + len, static_cast<unsigned char*>(dst)) ;
+	}
+	if(af == AF_INET6)
+	{
+		return pton6(src, src + len, static_cast<unsigned char*>(dst)) ;
+	}
+	throw std::system_error(EAFNOSUPPORT, std::generic_category()) ;
+}
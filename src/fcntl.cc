@@ -1,8 +1,12 @@
 #include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
 
 #include <system_error>
+#include <algorithm>
+#include <limits>
+#include <string>
 
 #include "fcntl.hh"
+#include "unistd.hh"
 
 /**
  * @brief fcntl.cc - file serves as CXX definitions of posicxx's file control functionality
@@ -83,16 +87,584 @@ int posicxx::open(const char* path, int oflag, const mode_t mode) noexcept(false
 
 void posicxx::posix_fadvise(int fd, off_t offset, off_t len, int advice) noexcept(false)
 {
-	if(::posix_fadvise(fd, offset, len, advice) != 0)
+	const int rfadvise = ::posix_fadvise(fd, offset, len, advice) ; // returns the error number rather than setting errno
+	if(rfadvise != 0)
 	{
-		throw std::system_error(errno, std::generic_category()) ;
+		throw std::system_error(rfadvise, std::generic_category()) ;
 	}
 }
 
 void posicxx::posix_fallocate(int fd, off_t offset, off_t len) noexcept(false)
 {
-	if(::posix_fallocate(fd, offset, len) != 0)
+	const int rfallocate = ::posix_fallocate(fd, offset, len) ; // returns the error number rather than setting errno
+	if(rfallocate != 0)
+	{
+		throw std::system_error(rfallocate, std::generic_category()) ;
+	}
+}
+
+#ifdef __linux__
+
+ssize_t posicxx::splice(int fd_in, off_t* off_in, int fd_out, off_t* off_out, size_t len, unsigned flags) noexcept(false)
+{
+	const ssize_t rsplice = ::splice(fd_in, off_in, fd_out, off_out, len, flags) ;
+
+	if(rsplice < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	return rsplice ;
+}
+
+void posicxx::sync_file_range(int fd, off_t offset, off_t nbytes, unsigned flags) noexcept(false)
+{
+	if(::sync_file_range(fd, offset, nbytes, flags) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+ssize_t posicxx::tee(int fd_in, int fd_out, size_t len, unsigned flags) noexcept(false)
+{
+	const ssize_t rtee = ::tee(fd_in, fd_out, len, flags) ;
+
+	if(rtee < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	return rtee ;
+}
+
+ssize_t posicxx::vmsplice(int fd, const struct iovec* iov, size_t nr_segs, unsigned flags) noexcept(false)
+{
+	const ssize_t rvmsplice = ::vmsplice(fd, iov, nr_segs, flags) ;
+
+	if(rvmsplice < 0)
 	{
 		throw std::system_error(errno, std::generic_category()) ;
 	}
+
+	return rvmsplice ;
+}
+
+#endif // #ifdef __linux__
+
+#ifdef F_OFD_SETLK
+
+namespace {
+
+	constexpr int lock_rank(const short type) noexcept
+	{
+		return type == F_WRLCK ? 2 : (type == F_RDLCK ? 1 : 0) ;
+	}
+
+	constexpr short lock_type(const int rank) noexcept
+	{
+		return rank == 2 ? F_WRLCK : (rank == 1 ? F_RDLCK : F_UNLCK) ;
+	}
+
+	constexpr off_t lock_eof = std::numeric_limits<off_t>::max() ; // end of ranges which run to the end of the file
+
+	/* second open file description of the managed file, opened on first need, so a read request can sleep as a reader without touching the manager's own locks */
+	struct Probe {
+		int fd = -1 ;
+		bool tried = false ;
+
+		bool open(int managed) noexcept
+		{
+			if(!this->tried)
+			{
+				this->tried = true ;
+				const std::string path = "/proc/self/fd/" + std::to_string(managed) ;
+				this->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC) ;
+			}
+			return this->fd >= 0 ;
+		}
+
+		~Probe() noexcept
+		{
+			if(this->fd >= 0)
+			{
+				::close(this->fd) ; // also drops anything still locked through it
+			}
+		}
+	} ;
+
+	void wait_probe(int fd, off_t start, off_t end) noexcept(false)
+	{
+		struct flock fl{} ;
+		fl.l_type = F_RDLCK ;
+		fl.l_whence = SEEK_SET ;
+		fl.l_start = start ;
+		fl.l_len = end == lock_eof ? 0 : end - start ;
+		fl.l_pid = 0 ;
+		if(::fcntl(fd, F_OFD_SETLKW, &fl) != 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+		fl.l_type = F_UNLCK ;
+		::fcntl(fd, F_OFD_SETLK, &fl) ;
+	}
+
+}
+
+bool posicxx::LockManager::Range::operator<(const Range& other) const noexcept
+{
+	if(this->start != other.start)
+	{
+		return this->start < other.start ;
+	}
+	if(this->end != other.end)
+	{
+		return this->end < other.end ;
+	}
+	return this->rank < other.rank ;
+}
+
+posicxx::LockManager::LockManager(const int fd) noexcept : _fd(fd), _held(), _stats(), _mutex()
+{
+}
+
+posicxx::LockManager::Range posicxx::LockManager::_range(off_t start, off_t len, short type) const noexcept(false)
+{
+	const int rank = lock_rank(type) ;
+
+	if(start < 0 || len < 0 || rank == 0 || (len != 0 && start > lock_eof - len))
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+
+	return Range{start, len == 0 ? lock_eof : start + len, rank} ;
+}
+
+std::vector<posicxx::LockManager::Range> posicxx::LockManager::_segments(off_t start, off_t end) const noexcept
+{
+	/* split [start, end) at every boundary of an overlapping held range, then find the strongest lock covering each piece */
+	std::vector<off_t> bounds{start, end} ;
+	for(auto it = this->_held.cbegin() ; it != this->_held.cend() && it->first.start < end ; ++it)
+	{
+		if(it->first.end <= start)
+		{
+			continue ;
+		}
+		if(it->first.start > start)
+		{
+			bounds.push_back(it->first.start) ;
+		}
+		if(it->first.end < end)
+		{
+			bounds.push_back(it->first.end) ;
+		}
+	}
+	std::sort(bounds.begin(), bounds.end()) ;
+	bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end()) ;
+
+	std::vector<Range> segments ;
+	for(std::size_t i = 0 ; i + 1 < bounds.size() ; ++i)
+	{
+		int rank = 0 ;
+		for(auto it = this->_held.cbegin() ; it != this->_held.cend() && it->first.start <= bounds[i] ; ++it)
+		{
+			if(it->first.end > bounds[i] && it->first.rank > rank)
+			{
+				rank = it->first.rank ;
+			}
+		}
+
+		if(!segments.empty() && segments.back().rank == rank)
+		{
+			segments.back().end = bounds[i + 1] ; // coalesce, saves a call when applying
+		}
+		else
+		{
+			segments.push_back(Range{bounds[i], bounds[i + 1], rank}) ;
+		}
+	}
+
+	return segments ;
+}
+
+bool posicxx::LockManager::_set(off_t start, off_t end, int rank, bool wait) noexcept(false)
+{
+	struct flock fl{} ;
+	fl.l_type = lock_type(rank) ;
+	fl.l_whence = SEEK_SET ;
+	fl.l_start = start ;
+	fl.l_len = end == lock_eof ? 0 : end - start ;
+	fl.l_pid = 0 ; // required to be zero for open file description locks
+
+	if(::fcntl(this->_fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &fl) != 0)
+	{
+		if(!wait && (errno == EAGAIN || errno == EACCES))
+		{
+			return false ;
+		}
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	return true ;
+}
+
+void posicxx::LockManager::_restore(off_t start, off_t end) noexcept(false)
+{
+	/* brings the kernel's view of [start, end) back in line with the table. Only ever releases or downgrades, so never blocks */
+	for(const Range& segment : this->_segments(start, end))
+	{
+		this->_set(segment.start, segment.end, segment.rank, false) ;
+		++this->_stats.syscalls ;
+	}
+}
+
+bool posicxx::LockManager::_acquire(const Range& range, Range* contended) noexcept(false)
+{
+	/* only the pieces held weaker than requested need the kernel - asking for the whole range could otherwise downgrade a write lock to a read lock */
+	const std::vector<Range> segments = this->_segments(range.start, range.end) ;
+
+	bool called = false ;
+	for(const Range& segment : segments)
+	{
+		if(segment.rank >= range.rank)
+		{
+			continue ;
+		}
+
+		called = true ;
+		++this->_stats.syscalls ;
+		if(!this->_set(segment.start, segment.end, range.rank, false))
+		{
+			++this->_stats.contended ;
+			*contended = segment ;
+			if(segment.start != range.start)
+			{
+				this->_restore(range.start, segment.start) ;
+			}
+			return false ;
+		}
+	}
+
+	if(!called)
+	{
+		++this->_stats.hits ;
+	}
+	++this->_held[range] ;
+
+	return true ;
+}
+
+void posicxx::LockManager::lock(off_t start, off_t len, short type) noexcept(false)
+{
+	const Range range = this->_range(start, len, type) ;
+
+	Range contended{} ;
+	Probe probe ;
+	std::unique_lock<std::mutex> guard(this->_mutex) ;
+	while(!this->_acquire(range, &contended))
+	{
+		/* sleep in the kernel on the contended piece without holding the table, so other threads may still use the manager meanwhile, then retry from scratch */
+		++this->_stats.waits ;
+		guard.unlock() ;
+
+		/* a reader waits as a reader on a separate description: it neither queues behind other readers nor excludes them, & can't downgrade the manager's own locks
+		 * (the manager holds nothing on a piece a read request contends, so the probe can't block on its own description's locks) */
+		if(range.rank == 1 && probe.open(this->_fd))
+		{
+			wait_probe(probe.fd, contended.start, contended.end) ;
+			guard.lock() ;
+			continue ;
+		}
+
+		/* a writer (or a reader without /proc) waits for a write lock on the manager's own description - a read lock there could downgrade a write lock another thread takes on that piece in the meantime
+		 * what it grants is then brought back in line with the table */
+		try
+		{
+			this->_set(contended.start, contended.end, 2, true) ;
+		}
+		catch(...)
+		{
+			guard.lock() ;
+			this->_restore(contended.start, contended.end) ;
+			throw ;
+		}
+		guard.lock() ;
+		this->_restore(contended.start, contended.end) ;
+	}
+}
+
+bool posicxx::LockManager::try_lock(off_t start, off_t len, short type) noexcept(false)
+{
+	const Range range = this->_range(start, len, type) ;
+
+	Range contended{} ;
+	std::lock_guard<std::mutex> guard(this->_mutex) ;
+	return this->_acquire(range, &contended) ;
+}
+
+void posicxx::LockManager::unlock(off_t start, off_t len, short type) noexcept(false)
+{
+	const Range range = this->_range(start, len, type) ;
+
+	std::lock_guard<std::mutex> guard(this->_mutex) ;
+	auto it = this->_held.find(range) ;
+	if(it == this->_held.end())
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+
+	if(--it->second == 0)
+	{
+		this->_held.erase(it) ;
+		this->_restore(range.start, range.end) ;
+	}
+}
+
+posicxx::LockManager::Stats posicxx::LockManager::stats() const noexcept
+{
+	std::lock_guard<std::mutex> guard(this->_mutex) ;
+	return this->_stats ;
+}
+
+posicxx::LockManager::~LockManager() noexcept
+{
+	if(!this->_held.empty())
+	{
+		struct flock fl{} ;
+		fl.l_type = F_UNLCK ;
+		fl.l_whence = SEEK_SET ;
+		::fcntl(this->_fd, F_OFD_SETLK, &fl) ; // nothing sensible to do on failure in a destructor
+	}
+}
+
+#endif // #ifdef F_OFD_SETLK
+
+#ifdef __linux__
+
+posicxx::Pipe::Pipe(int flags) noexcept(false) : _fds{-1, -1}
+{
+	posicxx::pipe2(this->_fds, flags) ;
+}
+
+posicxx::Pipe::Pipe(int flags, size_t capacity) noexcept(false) : Pipe(flags)
+{
+	this->resize(capacity) ;
+}
+
+int posicxx::Pipe::read_end() const noexcept
+{
+	return this->_fds[0] ;
+}
+
+int posicxx::Pipe::write_end() const noexcept
+{
+	return this->_fds[1] ;
+}
+
+size_t posicxx::Pipe::capacity() const noexcept(false)
+{
+	return static_cast<size_t>(posicxx::fcntl(this->_fds[1], F_GETPIPE_SZ)) ;
+}
+
+size_t posicxx::Pipe::resize(size_t capacity) noexcept(false)
+{
+	const size_t current = this->capacity() ;
+	const size_t ceiling = posicxx::Pipe::max_capacity() ;
+	size_t wanted = capacity < ceiling ? capacity : ceiling ;
+
+	while(true)
+	{
+		const int rfcntl = ::fcntl(this->_fds[1], F_SETPIPE_SZ, static_cast<int>(wanted)) ;
+		if(rfcntl >= 0)
+		{
+			return static_cast<size_t>(rfcntl) ;
+		}
+
+		if(errno != EPERM)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+
+		/* EPERM below the system maximum means the per-user pipe page limits were hit - back off towards what we have */
+		if(wanted / 2 <= current)
+		{
+			return current ;
+		}
+		wanted /= 2 ;
+	}
+}
+
+size_t posicxx::Pipe::max_capacity() noexcept(false)
+{
+	const int fd = posicxx::open("/proc/sys/fs/pipe-max-size", O_RDONLY | O_CLOEXEC) ;
+
+	char buf[32] = {0} ;
+	ssize_t len = 0 ;
+	try
+	{
+		len = posicxx::read(fd, buf, sizeof(buf) - 1) ;
+	}
+	catch(...)
+	{
+		::close(fd) ;
+		throw ;
+	}
+	::close(fd) ;
+
+	size_t capacity = 0 ;
+	for(ssize_t i = 0 ; i < len && buf[i] >= '0' && buf[i] <= '9' ; ++i)
+	{
+		capacity = capacity * 10 + static_cast<size_t>(buf[i] - '0') ;
+	}
+	if(capacity == 0)
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+
+	return capacity ;
+}
+
+ssize_t posicxx::Pipe::vmsplice(const struct iovec* iov, size_t nr_segs, unsigned flags) noexcept(false)
+{
+	return posicxx::vmsplice(this->_fds[1], iov, nr_segs, flags) ;
+}
+
+ssize_t posicxx::Pipe::tee(const Pipe& to, size_t len, unsigned flags) noexcept(false)
+{
+	return posicxx::tee(this->_fds[0], to._fds[1], len, flags) ;
+}
+
+ssize_t posicxx::Pipe::splice_to(int fd, off_t* offset, size_t len, unsigned flags) noexcept(false)
+{
+	return posicxx::splice(this->_fds[0], NULL, fd, offset, len, flags) ;
+}
+
+ssize_t posicxx::Pipe::splice_from(int fd, off_t* offset, size_t len, unsigned flags) noexcept(false)
+{
+	return posicxx::splice(fd, offset, this->_fds[1], NULL, len, flags) ;
+}
+
+posicxx::Pipe::Pipe(Pipe&& pipe) noexcept : _fds{pipe._fds[0], pipe._fds[1]}
+{
+	pipe._fds[0] = -1 ;
+	pipe._fds[1] = -1 ;
+}
+
+posicxx::Pipe& posicxx::Pipe::operator=(Pipe&& pipe) noexcept
+{
+	if(this != &pipe)
+	{
+		for(int i = 0 ; i < 2 ; ++i)
+		{
+			if(this->_fds[i] >= 0)
+			{
+				::close(this->_fds[i]) ;
+			}
+			this->_fds[i] = pipe._fds[i] ;
+			pipe._fds[i] = -1 ;
+		}
+	}
+
+	return *this ;
+}
+
+posicxx::Pipe::~Pipe() noexcept
+{
+	for(int i = 0 ; i < 2 ; ++i)
+	{
+		if(this->_fds[i] >= 0)
+		{
+			::close(this->_fds[i]) ;
+		}
+	}
+}
+
+#endif // #ifdef __linux__
+
+posicxx::StreamWriter::StreamWriter(int fd, size_t chunk, size_t window) noexcept(false) : _fd(fd), _start(0), _offset(0), _flushed(0), _evicted(0), _chunk(static_cast<off_t>(chunk == 0 ? 1 : chunk)), _window(static_cast<off_t>(window))
+{
+	this->_start = ::lseek(fd, 0, SEEK_CUR) ;
+	if(this->_start < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	this->_offset = this->_flushed = this->_evicted = this->_start ;
+}
+
+void posicxx::StreamWriter::_evict(off_t end) noexcept(false)
+{
+	if(end <= this->_evicted)
+	{
+		return ;
+	}
+
+	/* pages still dirty or under write-back aren't dropped by DONTNEED, so wait for their write-back to finish first */
+#ifdef __linux__
+	posicxx::sync_file_range(this->_fd, this->_evicted, end - this->_evicted, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER) ;
+#else
+	posicxx::fdatasync(this->_fd) ;
+#endif // #ifdef __linux__
+	posicxx::posix_fadvise(this->_fd, this->_evicted, end - this->_evicted, POSIX_FADV_DONTNEED) ;
+	this->_evicted = end ;
+}
+
+void posicxx::StreamWriter::_complete(bool all) noexcept(false)
+{
+	const off_t end = all ? this->_offset : this->_start + (this->_offset - this->_start) / this->_chunk * this->_chunk ;
+	if(end <= this->_flushed)
+	{
+		/* nothing new to write back, but a stream ending on a chunk boundary still has its window cached */
+		if(all)
+		{
+			this->_evict(end) ;
+		}
+		return ;
+	}
+
+#ifdef __linux__
+	/* start write-back of the newly completed chunks without waiting for it, so the disk works while we carry on writing */
+	posicxx::sync_file_range(this->_fd, this->_flushed, end - this->_flushed, SYNC_FILE_RANGE_WRITE) ;
+#endif // #ifdef __linux__
+	this->_flushed = end ;
+
+	/* drop whole chunks from the oldest until no more than the window remains cached */
+	if(all)
+	{
+		this->_evict(end) ;
+	}
+	else if(end - this->_evicted > this->_window)
+	{
+		const off_t excess = end - this->_evicted - this->_window ;
+		const off_t upto = this->_evicted + (excess + this->_chunk - 1) / this->_chunk * this->_chunk ;
+		this->_evict(upto < end ? upto : end) ;
+	}
+}
+
+void posicxx::StreamWriter::write(const void* buf, size_t nbyte) noexcept(false)
+{
+	const char* data = static_cast<const char*>(buf) ;
+	while(nbyte != 0)
+	{
+		const ssize_t rwrite = posicxx::write(this->_fd, data, nbyte) ;
+		data += rwrite ;
+		nbyte -= static_cast<size_t>(rwrite) ;
+		this->_offset += rwrite ;
+	}
+
+	this->_complete(false) ;
+}
+
+void posicxx::StreamWriter::finish() noexcept(false)
+{
+	this->_complete(true) ;
+	posicxx::fdatasync(this->_fd) ;
+}
+
+off_t posicxx::StreamWriter::written() const noexcept
+{
+	return this->_offset - this->_start ;
+}
+
+off_t posicxx::StreamWriter::cached() const noexcept
+{
+	return this->_offset - this->_evicted ;
 }
@@ -0,0 +1,267 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // #ifdef __linux__
+
+#include "net/if.hh"
+
+#ifdef __linux__
+
+namespace {
+
+	/* closes the MTU probe socket however the rebuild ends */
+	struct ProbeSocket {
+		int fd ;
+
+		ProbeSocket() noexcept : fd(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0))
+		{
+		}
+
+		~ProbeSocket() noexcept
+		{
+			if(this->fd >= 0)
+			{
+				::close(this->fd) ;
+			}
+		}
+
+		ProbeSocket(const ProbeSocket& probe) noexcept = delete ;
+		ProbeSocket& operator=(const ProbeSocket& probe) noexcept = delete ;
+	} ;
+
+}
+
+#endif // #ifdef __linux__
+
+/**
+ * @brief net/if.cc - file serves as CXX definitions of POSIX network interface functionality, containing the minimal wrapper & fancy interface
+ */
+
+char* posicxx::if_indextoname(unsigned ifindex, char* ifname) noexcept(false)
+{
+	char* const name = ::if_indextoname(ifindex, ifname) ;
+	if(name == nullptr)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return name ;
+}
+
+unsigned posicxx::if_nametoindex(const char* ifname) noexcept(false)
+{
+	const unsigned index = ::if_nametoindex(ifname) ;
+	if(index == 0)
+	{
+		throw std::system_error(errno != 0 ? errno : ENODEV, std::generic_category()) ;
+	}
+	return index ;
+}
+
+#ifdef __linux__
+
+const posicxx::InterfaceTable::Interface* posicxx::InterfaceTable::Snapshot::find(unsigned index) const noexcept
+{
+	const auto it = std::lower_bound(this->interfaces.begin(), this->interfaces.end(), index, [](const Interface& interface, unsigned key) {
+		return interface.index < key ;
+	}) ;
+	return it != this->interfaces.end() && it->index == index ? &*it : nullptr ;
+}
+
+const posicxx::InterfaceTable::Interface* posicxx::InterfaceTable::Snapshot::find(const char* name) const noexcept
+{
+	for(const Interface& interface : this->interfaces)
+	{
+		if(interface.name == name)
+		{
+			return &interface ;
+		}
+	}
+	return nullptr ;
+}
+
+posicxx::InterfaceTable::InterfaceTable(unsigned grace_ms) noexcept(false) : _netlink(-1), _grace(std::chrono::milliseconds(grace_ms)), _current(nullptr), _owned(), _retired()
+{
+	this->_netlink = ::socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE) ;
+	if(this->_netlink < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	struct sockaddr_nl local ;
+	std::memset(&local, 0, sizeof(local)) ;
+	local.nl_family = AF_NETLINK ;
+	local.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR ;
+
+	try
+	{
+		/* subscribed before the first build, so no change can slip in between */
+		if(::bind(this->_netlink, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+		this->_rebuild() ;
+	}
+	catch(...)
+	{
+		::close(this->_netlink) ;
+		throw ;
+	}
+}
+
+void posicxx::InterfaceTable::_rebuild() noexcept(false)
+{
+	struct ifaddrs* list ;
+	if(::getifaddrs(&list) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	std::unique_ptr<struct ifaddrs, void (*)(struct ifaddrs*)> guard(list, ::freeifaddrs) ;
+
+	const ProbeSocket probe ; // MTU is only available through an ioctl
+	std::unique_ptr<Snapshot> snapshot(new Snapshot()) ;
+
+	for(const struct ifaddrs* ifa = list ; ifa != nullptr ; ifa = ifa->ifa_next)
+	{
+		const unsigned index = ::if_nametoindex(ifa->ifa_name) ;
+		if(index == 0)
+		{
+			continue ; // vanished since getifaddrs; the pending notification triggers another rebuild
+		}
+
+		Interface* interface = nullptr ;
+		for(Interface& known : snapshot->interfaces)
+		{
+			if(known.index == index)
+			{
+				interface = &known ;
+				break ;
+			}
+		}
+		if(interface == nullptr)
+		{
+			snapshot->interfaces.push_back(Interface{ifa->ifa_name, index, ifa->ifa_flags, 0, {}}) ;
+			interface = &snapshot->interfaces.back() ;
+
+			struct ifreq request ;
+			std::memset(&request, 0, sizeof(request)) ;
+			std::strncpy(request.ifr_name, ifa->ifa_name, IFNAMSIZ - 1) ;
+			if(probe.fd >= 0 && ::ioctl(probe.fd, SIOCGIFMTU, &request) == 0)
+			{
+				interface->mtu = static_cast<unsigned>(request.ifr_mtu) ;
+			}
+		}
+
+		if(ifa->ifa_addr != nullptr && ifa->ifa_addr->sa_family == AF_INET)
+		{
+			interface->addresses.push_back(Endpoint::from_sockaddr(ifa->ifa_addr, sizeof(struct sockaddr_in))) ;
+		}
+		else if(ifa->ifa_addr != nullptr && ifa->ifa_addr->sa_family == AF_INET6)
+		{
+			interface->addresses.push_back(Endpoint::from_sockaddr(ifa->ifa_addr, sizeof(struct sockaddr_in6))) ;
+		}
+	}
+
+	std::sort(snapshot->interfaces.begin(), snapshot->interfaces.end(), [](const Interface& a, const Interface& b) {
+		return a.index < b.index ;
+	}) ;
+
+	snapshot->generation = this->_owned ? this->_owned->generation + 1 : 1 ;
+	if(this->_owned)
+	{
+		this->_retired.push_back(Retired{nullptr, Clock::now() + this->_grace}) ; // may throw, so before anything changes
+	}
+
+	this->_current.store(snapshot.get(), std::memory_order_release) ;
+	if(this->_owned)
+	{
+		this->_retired.back().snapshot = std::move(this->_owned) ;
+	}
+	this->_owned = std::move(snapshot) ;
+}
+
+void posicxx::InterfaceTable::_reclaim(Clock::time_point now) noexcept
+{
+	while(!this->_retired.empty() && this->_retired.front().freeable <= now)
+	{
+		this->_retired.pop_front() ;
+	}
+}
+
+const posicxx::InterfaceTable::Snapshot& posicxx::InterfaceTable::snapshot() const noexcept
+{
+	return *this->_current.load(std::memory_order_acquire) ;
+}
+
+int posicxx::InterfaceTable::fd() const noexcept
+{
+	return this->_netlink ;
+}
+
+bool posicxx::InterfaceTable::refresh() noexcept(false)
+{
+	bool changed = false ;
+	alignas(struct nlmsghdr) char buffer[8192] ;
+
+	for(;;)
+	{
+		const ssize_t received = ::recv(this->_netlink, buffer, sizeof(buffer), 0) ;
+		if(received < 0)
+		{
+			const std::error_code ec(errno, std::generic_category()) ;
+			if(ec == std::errc::no_buffer_space)
+			{
+				changed = true ; // notifications were dropped, so the snapshot can't be trusted
+				continue ;
+			}
+			if(ec == std::errc::interrupted)
+			{
+				continue ;
+			}
+			if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+			{
+				break ;
+			}
+			throw std::system_error(ec) ;
+		}
+
+		size_t len = static_cast<size_t>(received) ;
+		for(struct nlmsghdr* msg = reinterpret_cast<struct nlmsghdr*>(buffer) ; NLMSG_OK(msg, len) ; msg = NLMSG_NEXT(msg, len))
+		{
+			switch(msg->nlmsg_type)
+			{
+				case RTM_NEWLINK:
+				case RTM_DELLINK:
+				case RTM_NEWADDR:
+				case RTM_DELADDR:
+					changed = true ;
+					break ;
+				default:
+					break ;
+			}
+		}
+	}
+
+	if(changed)
+	{
+		this->_rebuild() ;
+	}
+	this->_reclaim(Clock::now()) ;
+	return changed ;
+}
+
+posicxx::InterfaceTable::~InterfaceTable() noexcept
+{
+	::close(this->_netlink) ;
+}
+
+#endif // #ifdef __linux__
@@ -0,0 +1,795 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+#ifdef __linux__
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // #ifdef __linux__
+
+#include "arpa/inet.hh"
+#include "netdb.hh"
+
+/**
+ * @brief netdb.cc - file serves as CXX definitions of POSIX network database functionality, containing the minimal wrapper & fancy interface
+ */
+
+namespace {
+
+	class GaiCategory : public std::error_category {
+		public:
+			const char* name() const noexcept override
+			{
+				return "gai" ;
+			}
+
+			std::string message(int condition) const override
+			{
+				return ::gai_strerror(condition) ;
+			}
+	} ;
+
+}
+
+const std::error_category& posicxx::gai_category() noexcept
+{
+	static const GaiCategory category ;
+	return category ;
+}
+
+posicxx::AddrInfo posicxx::getaddrinfo(const char* nodename, const char* servname, const struct addrinfo* hints) noexcept(false)
+{
+	struct addrinfo* res = nullptr ;
+	const int error = ::getaddrinfo(nodename, servname, hints, &res) ;
+	if(error == EAI_SYSTEM)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	if(error != 0)
+	{
+		throw std::system_error(error, gai_category()) ;
+	}
+	return AddrInfo(res, ::freeaddrinfo) ;
+}
+
+#ifdef __linux__
+
+namespace {
+
+	constexpr uint16_t dns_class_in = 1 ;
+	constexpr uint16_t dns_type_cname = 5 ;
+	constexpr uint16_t dns_type_soa = 6 ;
+	constexpr uint16_t dns_type_opt = 41 ;
+	constexpr uint16_t dns_edns_payload = 1232 ; // fits any path MTU without IP fragmentation
+	constexpr uint32_t dns_max_ttl = 86400 ;
+	constexpr size_t dns_max_chain = 8 ; // CNAME hops followed within one answer
+
+	uint16_t get16(const uint8_t* p) noexcept
+	{
+		return static_cast<uint16_t>(p[0] << 8 | p[1]) ;
+	}
+
+	uint32_t get32(const uint8_t* p) noexcept
+	{
+		return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 | static_cast<uint32_t>(p[2]) << 8 | p[3] ;
+	}
+
+	uint8_t* put16(uint8_t* p, uint16_t value) noexcept
+	{
+		p[0] = static_cast<uint8_t>(value >> 8) ;
+		p[1] = static_cast<uint8_t>(value) ;
+		return p + 2 ;
+	}
+
+	/* lower-cases name & strips a trailing dot, rejecting empty labels & names too long for the wire */
+	bool normalize(const char* name, std::string* out) noexcept(false)
+	{
+		out->assign(name) ;
+		if(!out->empty() && out->back() == '.')
+		{
+			out->pop_back() ;
+		}
+		if(out->empty() || out->size() > 253)
+		{
+			return false ;
+		}
+
+		size_t label = 0 ;
+		for(char& c : *out)
+		{
+			if(c == '.')
+			{
+				if(label == 0)
+				{
+					return false ;
+				}
+				label = 0 ;
+				continue ;
+			}
+			if(++label > 63)
+			{
+				return false ;
+			}
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c))) ;
+		}
+		return label != 0 ;
+	}
+
+	/* decodes the (possibly compressed) name at *offset into lower-case dotted form, advancing *offset past it */
+	bool read_name(const uint8_t* msg, size_t len, size_t* offset, std::string* out) noexcept(false)
+	{
+		size_t pos = *offset ;
+		size_t jumps = 0 ;
+		bool jumped = false ;
+		out->clear() ;
+
+		for(;;)
+		{
+			if(pos >= len)
+			{
+				return false ;
+			}
+			const uint8_t length = msg[pos] ;
+			if((length & 0xC0) == 0xC0)
+			{
+				if(pos + 1 >= len || ++jumps > 64)
+				{
+					return false ;
+				}
+				if(!jumped)
+				{
+					*offset = pos + 2 ;
+					jumped = true ;
+				}
+				pos = static_cast<size_t>(length & 0x3F) << 8 | msg[pos + 1] ;
+				continue ;
+			}
+			if(length & 0xC0)
+			{
+				return false ;
+			}
+			if(length == 0)
+			{
+				if(!jumped)
+				{
+					*offset = pos + 1 ;
+				}
+				return true ;
+			}
+			if(pos + 1 + length > len || out->size() + length + 1 > 255)
+			{
+				return false ;
+			}
+			if(!out->empty())
+			{
+				out->push_back('.') ;
+			}
+			for(size_t i = 0 ; i < length ; ++i)
+			{
+				out->push_back(static_cast<char>(std::tolower(msg[pos + 1 + i]))) ;
+			}
+			pos += 1 + length ;
+		}
+	}
+
+	struct Record {
+		std::string owner ;
+		uint16_t type ;
+		uint16_t klass ;
+		uint32_t ttl ;
+		size_t rdata ; // offset into the message
+		uint16_t rdlength ;
+	} ;
+
+	bool read_record(const uint8_t* msg, size_t len, size_t* offset, Record* record) noexcept(false)
+	{
+		if(!read_name(msg, len, offset, &record->owner) || *offset + 10 > len)
+		{
+			return false ;
+		}
+		const uint8_t* p = msg + *offset ;
+		record->type = get16(p) ;
+		record->klass = get16(p + 2) ;
+		record->ttl = std::min(get32(p + 4), dns_max_ttl) ;
+		record->rdlength = get16(p + 8) ;
+		record->rdata = *offset + 10 ;
+		*offset = record->rdata + record->rdlength ;
+		return *offset <= len ;
+	}
+
+	/* negative-caching time of an NXDOMAIN / NODATA answer (RFC 2308): the SOA's TTL capped by its minimum field, 0 without an SOA */
+	uint32_t negative_ttl(const uint8_t* msg, size_t len, size_t offset, uint16_t count) noexcept(false)
+	{
+		Record record ;
+		std::string name ;
+		for(uint16_t i = 0 ; i < count ; ++i)
+		{
+			if(!read_record(msg, len, &offset, &record))
+			{
+				return 0 ;
+			}
+			if(record.type != dns_type_soa)
+			{
+				continue ;
+			}
+			size_t rdata = record.rdata ;
+			if(!read_name(msg, len, &rdata, &name) || !read_name(msg, len, &rdata, &name) || rdata + 20 > record.rdata + record.rdlength)
+			{
+				return 0 ;
+			}
+			return std::min(record.ttl, get32(msg + rdata + 16)) ;
+		}
+		return 0 ;
+	}
+
+	/* settings taken from resolv.conf, falling back to its documented defaults */
+	struct ResolvConf {
+		posicxx::Endpoint nameserver = posicxx::Endpoint::v4(0x7F000001, 53) ;
+		unsigned timeout_ms = 5000 ;
+		unsigned attempts = 2 ;
+	} ;
+
+	ResolvConf read_resolv_conf(const char* path) noexcept(false)
+	{
+		ResolvConf conf ;
+		bool found = false ;
+		std::ifstream file(path) ;
+		std::string line ;
+
+		while(std::getline(file, line))
+		{
+			std::istringstream fields(line) ;
+			std::string keyword ;
+			fields >> keyword ;
+
+			if(keyword == "nameserver" && !found)
+			{
+				std::string address ;
+				fields >> address ;
+				uint32_t scope = 0 ;
+				const size_t percent = address.find('%') ;
+				if(percent != std::string::npos)
+				{
+					const std::string zone = address.substr(percent + 1) ;
+					scope = ::if_nametoindex(zone.c_str()) ;
+					if(scope == 0)
+					{
+						scope = static_cast<uint32_t>(std::strtoul(zone.c_str(), nullptr, 10)) ;
+					}
+					address.resize(percent) ;
+				}
+
+				uint8_t bytes[16] ;
+				if(posicxx::inet_pton(AF_INET, address.c_str(), bytes))
+				{
+					conf.nameserver = posicxx::Endpoint::v4(get32(bytes), 53) ;
+					found = true ;
+				}
+				else if(posicxx::inet_pton(AF_INET6, address.c_str(), bytes))
+				{
+					conf.nameserver = posicxx::Endpoint::v6(bytes, 53, scope) ;
+					found = true ;
+				}
+			}
+			else if(keyword == "options")
+			{
+				std::string option ;
+				while(fields >> option)
+				{
+					if(option.compare(0, 8, "timeout:") == 0)
+					{
+						conf.timeout_ms = std::max(1UL, std::min(30UL, std::strtoul(option.c_str() + 8, nullptr, 10))) * 1000 ;
+					}
+					else if(option.compare(0, 9, "attempts:") == 0)
+					{
+						conf.attempts = static_cast<unsigned>(std::max(1UL, std::min(5UL, std::strtoul(option.c_str() + 9, nullptr, 10)))) ;
+					}
+				}
+			}
+		}
+		return conf ;
+	}
+
+}
+
+posicxx::Resolver::Resolver() noexcept(false) : _fd(-1), _timeout_ms(0), _attempts(0), _rng(0), _swept(Clock::now()), _hosts(), _cache(), _queries(), _pending()
+{
+	const ResolvConf conf = read_resolv_conf("/etc/resolv.conf") ;
+	this->_timeout_ms = conf.timeout_ms ;
+	this->_attempts = conf.attempts ;
+	this->_load_hosts("/etc/hosts") ;
+	this->_connect(conf.nameserver) ;
+}
+
+posicxx::Resolver::Resolver(const Endpoint& nameserver, const char* hosts, unsigned timeout_ms, unsigned attempts) noexcept(false) : _fd(-1), _timeout_ms(std::max(timeout_ms, 1U)), _attempts(std::max(attempts, 1U)), _rng(0), _swept(Clock::now()), _hosts(), _cache(), _queries(), _pending()
+{
+	if(hosts != nullptr)
+	{
+		this->_load_hosts(hosts) ;
+	}
+	this->_connect(nameserver) ;
+}
+
+void posicxx::Resolver::_connect(const Endpoint& nameserver) noexcept(false)
+{
+	struct sockaddr_storage addr ;
+	const socklen_t addrlen = nameserver.to_sockaddr(&addr) ;
+	if(addrlen == 0)
+	{
+		throw std::system_error(EAFNOSUPPORT, std::generic_category()) ;
+	}
+
+	/* the socket (& so its source port) lasts as long as the resolver, leaving the 16-bit id & the echoed question as the only defence against forged answers, so ids are unpredictable */
+	std::random_device device ;
+	this->_rng = static_cast<uint64_t>(device()) << 32 | device() | 1 ;
+
+	this->_fd = ::socket(nameserver.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0) ;
+	if(this->_fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	if(::connect(this->_fd, reinterpret_cast<struct sockaddr*>(&addr), addrlen) != 0)
+	{
+		const int error = errno ;
+		::close(this->_fd) ;
+		throw std::system_error(error, std::generic_category()) ;
+	}
+}
+
+void posicxx::Resolver::_load_hosts(const char* path) noexcept(false)
+{
+	std::ifstream file(path) ;
+	std::string line ;
+
+	while(std::getline(file, line))
+	{
+		line.erase(std::min(line.find('#'), line.size())) ;
+		std::istringstream fields(line) ;
+		std::string address ;
+		if(!(fields >> address))
+		{
+			continue ;
+		}
+
+		uint8_t bytes[16] ;
+		Endpoint endpoint ;
+		if(posicxx::inet_pton(AF_INET, address.c_str(), bytes))
+		{
+			endpoint = Endpoint::v4(get32(bytes), 0) ;
+		}
+		else if(address.find('%') == std::string::npos && posicxx::inet_pton(AF_INET6, address.c_str(), bytes))
+		{
+			endpoint = Endpoint::v6(bytes, 0) ;
+		}
+		else
+		{
+			continue ;
+		}
+
+		std::string alias ;
+		std::string name ;
+		while(fields >> alias)
+		{
+			if(normalize(alias.c_str(), &name))
+			{
+				std::vector<Endpoint>& addresses = this->_hosts[name] ;
+				if(std::find(addresses.begin(), addresses.end(), endpoint) == addresses.end())
+				{
+					addresses.push_back(endpoint) ;
+				}
+			}
+		}
+	}
+}
+
+void posicxx::Resolver::_sweep(Clock::time_point now) noexcept
+{
+	/* expired entries are otherwise only dropped when looked up again, which never happens for one-off names */
+	if(now - this->_swept < std::chrono::seconds(60))
+	{
+		return ;
+	}
+	for(auto it = this->_cache.begin() ; it != this->_cache.end() ; )
+	{
+		it = it->second.expiry <= now ? this->_cache.erase(it) : std::next(it) ;
+	}
+	this->_swept = now ;
+}
+
+void posicxx::Resolver::_send(const Query& query) noexcept
+{
+	uint8_t packet[12 + 255 + 4 + 11] ;
+	uint8_t* p = packet ;
+	p = put16(p, query.id) ;
+	p = put16(p, 0x0100) ; // standard query, recursion desired
+	p = put16(p, 1) ;
+	p = put16(p, 0) ;
+	p = put16(p, 0) ;
+	p = put16(p, 1) ;
+
+	const char* name = query.key.c_str() + 1 ;
+	while(*name != '\0')
+	{
+		const char* dot = std::strchr(name, '.') ;
+		const size_t length = dot != nullptr ? static_cast<size_t>(dot - name) : std::strlen(name) ;
+		*p++ = static_cast<uint8_t>(length) ;
+		std::memcpy(p, name, length) ;
+		p += length ;
+		name += dot != nullptr ? length + 1 : length ;
+	}
+	*p++ = 0 ;
+	p = put16(p, static_cast<uint8_t>(query.key[0])) ;
+	p = put16(p, dns_class_in) ;
+
+	/* EDNS(0) OPT pseudo-record, advertising answers larger than 512 bytes */
+	*p++ = 0 ;
+	p = put16(p, dns_type_opt) ;
+	p = put16(p, dns_edns_payload) ;
+	p = put16(p, 0) ;
+	p = put16(p, 0) ;
+	p = put16(p, 0) ;
+
+	/* a lost or refused send is recovered from like a lost answer: by expire() */
+	(void)::send(this->_fd, packet, static_cast<size_t>(p - packet), MSG_NOSIGNAL) ;
+}
+
+void posicxx::Resolver::_complete(uint16_t id, int error, const std::vector<Endpoint>& addresses, uint32_t ttl) noexcept(false)
+{
+	const auto it = this->_queries.find(id) ;
+	Query query = std::move(it->second) ;
+	this->_queries.erase(it) ;
+	this->_pending.erase(query.key) ;
+
+	if(ttl > 0)
+	{
+		this->_cache[query.key] = Entry{error == 0 ? addresses : std::vector<Endpoint>(), error, Clock::now() + std::chrono::seconds(ttl)} ;
+	}
+
+	/* the query is out of the tables by now, so callbacks may resolve again
+	 * every coalesced lookup is completed even if one callback throws; the first exception is rethrown afterwards */
+	static const std::vector<Endpoint> none ;
+	const std::error_code ec = error != 0 ? std::error_code(error, gai_category()) : std::error_code() ;
+	std::exception_ptr thrown ;
+	for(const Callback& callback : query.callbacks)
+	{
+		try
+		{
+			callback(ec, error != 0 ? none : addresses) ;
+		}
+		catch(...)
+		{
+			if(!thrown)
+			{
+				thrown = std::current_exception() ;
+			}
+		}
+	}
+	if(thrown)
+	{
+		std::rethrow_exception(thrown) ;
+	}
+}
+
+bool posicxx::Resolver::_answer(const uint8_t* msg, size_t len) noexcept(false)
+{
+	if(len < 12)
+	{
+		return false ;
+	}
+	const auto it = this->_queries.find(get16(msg)) ;
+	const uint16_t flags = get16(msg + 2) ;
+	if(it == this->_queries.end() || !(flags & 0x8000) || get16(msg + 4) != 1)
+	{
+		return false ;
+	}
+
+	/* the question must echo ours, otherwise it's a stale or forged answer & the query keeps waiting */
+	const Query& query = it->second ;
+	const uint16_t type = static_cast<uint8_t>(query.key[0]) ;
+	std::string name ;
+	size_t offset = 12 ;
+	if(!read_name(msg, len, &offset, &name) || offset + 4 > len || name.compare(query.key.c_str() + 1) != 0 || get16(msg + offset) != type || get16(msg + offset + 2) != dns_class_in)
+	{
+		return false ;
+	}
+	offset += 4 ;
+
+	const uint16_t id = query.id ;
+	const uint16_t answers = get16(msg + 6) ;
+	const uint16_t authorities = get16(msg + 8) ;
+
+	switch(flags & 0x000F)
+	{
+		case 0:
+			break ;
+		case 2: // SERVFAIL
+			this->_complete(id, EAI_AGAIN, {}, 0) ;
+			return true ;
+		case 3: // NXDOMAIN
+		{
+			size_t authority = offset ;
+			Record record ;
+			for(uint16_t i = 0 ; i < answers ; ++i)
+			{
+				if(!read_record(msg, len, &authority, &record))
+				{
+					this->_complete(id, EAI_NONAME, {}, 0) ;
+					return true ;
+				}
+			}
+			this->_complete(id, EAI_NONAME, {}, negative_ttl(msg, len, authority, authorities)) ;
+			return true ;
+		}
+		default:
+			this->_complete(id, EAI_FAIL, {}, 0) ;
+			return true ;
+	}
+
+	std::vector<Record> records(answers) ;
+	for(Record& record : records)
+	{
+		if(!read_record(msg, len, &offset, &record))
+		{
+			this->_complete(id, EAI_FAIL, {}, 0) ;
+			return true ;
+		}
+	}
+
+	/* follow the CNAME chain from the name asked for, so only addresses of names it leads to are taken */
+	uint32_t ttl = dns_max_ttl ;
+	std::vector<std::string> chain{std::move(name)} ;
+	for(bool followed = true ; followed && chain.size() <= dns_max_chain ; )
+	{
+		followed = false ;
+		for(const Record& record : records)
+		{
+			std::string target ;
+			size_t rdata = record.rdata ;
+			if(record.type == dns_type_cname && record.owner == chain.back() && read_name(msg, len, &rdata, &target) && std::find(chain.begin(), chain.end(), target) == chain.end())
+			{
+				ttl = std::min(ttl, record.ttl) ;
+				chain.push_back(std::move(target)) ;
+				followed = true ;
+				break ;
+			}
+		}
+	}
+
+	std::vector<Endpoint> addresses ;
+	for(const Record& record : records)
+	{
+		if(record.type != type || record.klass != dns_class_in || std::find(chain.begin(), chain.end(), record.owner) == chain.end())
+		{
+			continue ;
+		}
+		if(record.rdlength == 4)
+		{
+			addresses.push_back(Endpoint::v4(get32(msg + record.rdata), 0)) ;
+		}
+		else if(record.rdlength == 16)
+		{
+			uint8_t bytes[16] ;
+			std::memcpy(bytes, msg + record.rdata, sizeof(bytes)) ;
+			addresses.push_back(Endpoint::v6(bytes, 0)) ;
+		}
+		else
+		{
+			continue ;
+		}
+		ttl = std::min(ttl, record.ttl) ;
+	}
+
+	if(addresses.empty() && (flags & 0x0200))
+	{
+		this->_complete(id, EAI_FAIL, {}, 0) ; // truncated & lost its addresses, which says nothing about the name; there's no TCP fallback
+		return true ;
+	}
+	if(addresses.empty()) // NODATA
+	{
+		this->_complete(id, EAI_NONAME, {}, negative_ttl(msg, len, offset, authorities)) ;
+		return true ;
+	}
+	this->_complete(id, 0, addresses, ttl) ;
+	return true ;
+}
+
+bool posicxx::Resolver::resolve(const char* name, Family family, Callback callback) noexcept(false)
+{
+	const int af = family == Family::ipv4 ? AF_INET : AF_INET6 ;
+	uint8_t bytes[16] ;
+	if(posicxx::inet_pton(af, name, bytes))
+	{
+		callback(std::error_code(), std::vector<Endpoint>{af == AF_INET ? Endpoint::v4(get32(bytes), 0) : Endpoint::v6(bytes, 0)}) ;
+		return true ;
+	}
+	if(posicxx::inet_pton(af == AF_INET ? AF_INET6 : AF_INET, name, bytes))
+	{
+		callback(std::error_code(EAI_NONAME, gai_category()), std::vector<Endpoint>()) ;
+		return true ;
+	}
+
+	std::string key(1, static_cast<char>(family)) ;
+	std::string normalized ;
+	if(!normalize(name, &normalized))
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+	key += normalized ;
+
+	const auto host = this->_hosts.find(normalized) ;
+	if(host != this->_hosts.end())
+	{
+		std::vector<Endpoint> addresses ;
+		for(const Endpoint& endpoint : host->second)
+		{
+			if(endpoint.family() == af)
+			{
+				addresses.push_back(endpoint) ;
+			}
+		}
+		if(!addresses.empty())
+		{
+			callback(std::error_code(), addresses) ;
+			return true ;
+		}
+	}
+
+	const Clock::time_point now = Clock::now() ;
+	this->_sweep(now) ;
+	const auto cached = this->_cache.find(key) ;
+	if(cached != this->_cache.end())
+	{
+		if(cached->second.expiry > now)
+		{
+			const Entry entry = cached->second ; // copied, as the callback may flush the cache
+			callback(entry.error != 0 ? std::error_code(entry.error, gai_category()) : std::error_code(), entry.addresses) ;
+			return true ;
+		}
+		this->_cache.erase(cached) ;
+	}
+
+	const auto pending = this->_pending.find(key) ;
+	if(pending != this->_pending.end())
+	{
+		this->_queries[pending->second].callbacks.push_back(std::move(callback)) ;
+		return false ;
+	}
+
+	if(this->_queries.size() > UINT16_MAX)
+	{
+		throw std::system_error(ENOBUFS, std::generic_category()) ;
+	}
+	uint16_t id ;
+	do
+	{
+		this->_rng ^= this->_rng >> 12 ;
+		this->_rng ^= this->_rng << 25 ;
+		this->_rng ^= this->_rng >> 27 ;
+		id = static_cast<uint16_t>((this->_rng * 0x2545F4914F6CDD1DULL) >> 48) ;
+	}
+	while(this->_queries.count(id) != 0) ;
+
+	Query& query = this->_queries[id] ;
+	query.key = key ;
+	query.id = id ;
+	query.attempts = 1 ;
+	query.deadline = now + std::chrono::milliseconds(this->_timeout_ms) ;
+	query.callbacks.push_back(std::move(callback)) ;
+	this->_pending.emplace(std::move(key), id) ;
+	this->_send(query) ;
+	return false ;
+}
+
+int posicxx::Resolver::fd() const noexcept
+{
+	return this->_fd ;
+}
+
+size_t posicxx::Resolver::process() noexcept(false)
+{
+	size_t completed = 0 ;
+	uint8_t buffer[4096] ;
+
+	for(;;)
+	{
+		const ssize_t received = ::recv(this->_fd, buffer, sizeof(buffer), 0) ;
+		if(received < 0)
+		{
+			const std::error_code ec(errno, std::generic_category()) ;
+			if(ec == std::errc::interrupted || ec == std::errc::connection_refused)
+			{
+				continue ; // a refused query is resent by expire()
+			}
+			if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+			{
+				break ;
+			}
+			throw std::system_error(ec) ;
+		}
+		if(this->_answer(buffer, static_cast<size_t>(received)))
+		{
+			++completed ;
+		}
+	}
+	this->_sweep(Clock::now()) ;
+	return completed ;
+}
+
+size_t posicxx::Resolver::expire() noexcept(false)
+{
+	const Clock::time_point now = Clock::now() ;
+	std::vector<uint16_t> failed ;
+
+	for(auto& entry : this->_queries)
+	{
+		Query& query = entry.second ;
+		if(query.deadline > now)
+		{
+			continue ;
+		}
+		if(query.attempts >= this->_attempts)
+		{
+			failed.push_back(query.id) ;
+			continue ;
+		}
+		++query.attempts ;
+		query.deadline = now + std::chrono::milliseconds(this->_timeout_ms) ;
+		this->_send(query) ;
+	}
+
+	for(const uint16_t id : failed)
+	{
+		this->_complete(id, EAI_AGAIN, {}, 0) ; // ids stay taken until completed, so a callback's new query can't reuse one
+	}
+
+	this->_sweep(now) ;
+	return failed.size() ;
+}
+
+int posicxx::Resolver::timeout() const noexcept
+{
+	if(this->_queries.empty())
+	{
+		return -1 ;
+	}
+	Clock::time_point earliest = Clock::time_point::max() ;
+	for(const auto& entry : this->_queries)
+	{
+		earliest = std::min(earliest, entry.second.deadline) ;
+	}
+	const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(earliest - Clock::now()).count() ;
+	return remaining > 0 ? static_cast<int>((remaining + 999) / 1000) : 0 ; // rounded up, so the deadline has passed when woken
+}
+
+size_t posicxx::Resolver::pending() const noexcept
+{
+	return this->_queries.size() ;
+}
+
+size_t posicxx::Resolver::cached() const noexcept
+{
+	return this->_cache.size() ;
+}
+
+void posicxx::Resolver::flush() noexcept
+{
+	this->_cache.clear() ;
+}
+
+posicxx::Resolver::~Resolver() noexcept
+{
+	::close(this->_fd) ;
+}
+
+#endif // #ifdef __linux__
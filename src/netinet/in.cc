@@ -0,0 +1,97 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+#include <cstdio>
+#include <cstring>
+
+#include "arpa/inet.hh"
+#include "netinet/in.hh"
+
+/**
+ * @brief netinet/in.cc - file serves as CXX definitions of internet protocol family functionality, containing the fancy interface
+ */
+
+posicxx::Endpoint posicxx::Endpoint::from_sockaddr(const struct sockaddr* addr, socklen_t addrlen) noexcept(false)
+{
+	if(addr->sa_family == AF_INET)
+	{
+		if(addrlen < sizeof(struct sockaddr_in))
+		{
+			throw std::system_error(EINVAL, std::generic_category()) ;
+		}
+		struct sockaddr_in in ;
+		std::memcpy(&in, addr, sizeof(in)) ;
+		return Endpoint::v4(ntohl(in.sin_addr.s_addr), ntohs(in.sin_port)) ;
+	}
+	if(addr->sa_family == AF_INET6)
+	{
+		if(addrlen < sizeof(struct sockaddr_in6))
+		{
+			throw std::system_error(EINVAL, std::generic_category()) ;
+		}
+		struct sockaddr_in6 in6 ;
+		std::memcpy(&in6, addr, sizeof(in6)) ;
+		return Endpoint::v6(in6.sin6_addr.s6_addr, ntohs(in6.sin6_port), in6.sin6_scope_id) ;
+	}
+	throw std::system_error(EAFNOSUPPORT, std::generic_category()) ;
+}
+
+socklen_t posicxx::Endpoint::to_sockaddr(struct sockaddr_storage* addr) const noexcept
+{
+	std::memset(addr, 0, sizeof(*addr)) ;
+
+	if(this->_family == AF_INET)
+	{
+		struct sockaddr_in in ;
+		std::memset(&in, 0, sizeof(in)) ;
+		in.sin_family = AF_INET ;
+		in.sin_port = htons(this->_port) ;
+		std::memcpy(&in.sin_addr, this->_addr, 4) ;
+		std::memcpy(addr, &in, sizeof(in)) ;
+		return sizeof(in) ;
+	}
+	if(this->_family == AF_INET6)
+	{
+		struct sockaddr_in6 in6 ;
+		std::memset(&in6, 0, sizeof(in6)) ;
+		in6.sin6_family = AF_INET6 ;
+		in6.sin6_port = htons(this->_port) ;
+		in6.sin6_scope_id = this->_scope ;
+		std::memcpy(&in6.sin6_addr, this->_addr, 16) ;
+		std::memcpy(addr, &in6, sizeof(in6)) ;
+		return sizeof(in6) ;
+	}
+	return 0 ;
+}
+
+const char* posicxx::Endpoint::format(char* dst, size_t size) const noexcept(false)
+{
+	char text[INET6_ADDRSTRLEN] = "" ;
+	int len ;
+
+	if(this->_family == AF_INET)
+	{
+		posicxx::inet_ntop(AF_INET, this->_addr, text, sizeof(text)) ;
+		len = std::snprintf(dst, size, "%s:%u", text, static_cast<unsigned>(this->_port)) ;
+	}
+	else if(this->_family == AF_INET6 && this->_scope != 0)
+	{
+		posicxx::inet_ntop(AF_INET6, this->_addr, text, sizeof(text)) ;
+		len = std::snprintf(dst, size, "[%s%%%u]:%u", text, static_cast<unsigned>(this->_scope), static_cast<unsigned>(this->_port)) ;
+	}
+	else if(this->_family == AF_INET6)
+	{
+		posicxx::inet_ntop(AF_INET6, this->_addr, text, sizeof(text)) ;
+		len = std::snprintf(dst, size, "[%s]:%u", text, static_cast<unsigned>(this->_port)) ;
+	}
+	else
+	{
+		len = std::snprintf(dst, size, "%s", "unspecified") ;
+	}
+
+	if(len < 0 || static_cast<size_t>(len) >= size)
+	{
+		throw std::system_error(ENOSPC, std::generic_category()) ;
+	}
+	return dst ;
+}
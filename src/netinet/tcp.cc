@@ -0,0 +1,335 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <sched.h>
+
+#include <system_error>
+#include <cstring>
+#include <ctime>
+
+#include "netinet/tcp.hh"
+#include "sys/socket.hh"
+
+/**
+ * @brief netinet/tcp.cc - file serves as CXX definitions of TCP protocol functionality, containing the fancy interface
+ */
+
+void posicxx::set_tcp_nodelay(int sockfd, bool enable) noexcept(false)
+{
+	posicxx::setsockopt<sockopt::tcp_nodelay>(sockfd, enable ? 1 : 0) ;
+}
+
+#if defined(TCP_CORK) && defined(MSG_MORE)
+
+void posicxx::set_tcp_cork(int sockfd, bool enable) noexcept(false)
+{
+	posicxx::setsockopt<sockopt::tcp_cork>(sockfd, enable ? 1 : 0) ;
+}
+
+posicxx::CorkedWriter::CorkedWriter(int sockfd, Mode mode) noexcept : _fd(sockfd), _mode(mode), _corked(false)
+{
+}
+
+void posicxx::CorkedWriter::_cork() noexcept(false)
+{
+	if(this->_mode == Mode::cork && !this->_corked)
+	{
+		posicxx::set_tcp_cork(this->_fd, true) ;
+		this->_corked = true ;
+	}
+}
+
+ssize_t posicxx::CorkedWriter::write(const void* buf, size_t len, int flags) noexcept(false)
+{
+	this->_cork() ;
+	return posicxx::send(this->_fd, buf, len, this->_mode == Mode::more ? flags | MSG_MORE : flags) ;
+}
+
+ssize_t posicxx::CorkedWriter::write(const struct iovec* iov, size_t iovlen, int flags) noexcept(false)
+{
+	this->_cork() ;
+
+	struct msghdr msg{} ;
+	msg.msg_iov = const_cast<struct iovec*>(iov) ;
+	msg.msg_iovlen = iovlen ;
+	return posicxx::sendmsg(this->_fd, &msg, this->_mode == Mode::more ? flags | MSG_MORE : flags) ;
+}
+
+ssize_t posicxx::CorkedWriter::write(const void* buf, size_t len, int flags, std::error_code& ec) noexcept
+{
+	if(this->_mode == Mode::cork && !this->_corked)
+	{
+		const int one = 1 ;
+		if(::setsockopt(this->_fd, IPPROTO_TCP, TCP_CORK, &one, sizeof(one)) != 0)
+		{
+			ec = std::error_code(errno, std::generic_category()) ;
+			return -1 ;
+		}
+		this->_corked = true ;
+	}
+	return posicxx::send(this->_fd, buf, len, this->_mode == Mode::more ? flags | MSG_MORE : flags, ec) ;
+}
+
+ssize_t posicxx::CorkedWriter::flush(const void* buf, size_t len, int flags) noexcept(false)
+{
+	const ssize_t sent = posicxx::send(this->_fd, buf, len, flags) ;
+
+	/* a short send leaves the rest for another flush, which uncorks once it's all out */
+	if(static_cast<size_t>(sent) == len && this->_corked)
+	{
+		posicxx::set_tcp_cork(this->_fd, false) ;
+		this->_corked = false ;
+	}
+	return sent ;
+}
+
+void posicxx::CorkedWriter::flush() noexcept(false)
+{
+	if(this->_mode == Mode::more)
+	{
+		posicxx::set_tcp_nodelay(this->_fd, true) ;
+	}
+	else if(this->_corked)
+	{
+		posicxx::set_tcp_cork(this->_fd, false) ;
+		this->_corked = false ;
+	}
+}
+
+posicxx::CorkedWriter::Mode posicxx::CorkedWriter::mode() const noexcept
+{
+	return this->_mode ;
+}
+
+posicxx::CorkedWriter::~CorkedWriter() noexcept
+{
+	if(this->_corked)
+	{
+		const int zero = 0 ;
+		::setsockopt(this->_fd, IPPROTO_TCP, TCP_CORK, &zero, sizeof(zero)) ;
+	}
+}
+
+#endif // #if defined(TCP_CORK) && defined(MSG_MORE)
+
+#ifdef TCP_INFO
+
+void posicxx::get_tcp_info(int sockfd, TcpInfo* info, std::error_code& ec) noexcept
+{
+	struct tcp_info raw ;
+	std::memset(&raw, 0, sizeof(raw)) ;
+	socklen_t len = sizeof(raw) ;
+	if(::getsockopt(sockfd, IPPROTO_TCP, TCP_INFO, &raw, &len) != 0)
+	{
+		ec = std::error_code(errno, std::generic_category()) ;
+		return ;
+	}
+	ec = std::error_code() ;
+
+	info->state = raw.tcpi_state ;
+	info->ca_state = raw.tcpi_ca_state ;
+	info->retransmits = raw.tcpi_retransmits ;
+	info->rto_us = raw.tcpi_rto ;
+	info->rtt_us = raw.tcpi_rtt ;
+	info->rttvar_us = raw.tcpi_rttvar ;
+	info->snd_mss = raw.tcpi_snd_mss ;
+	info->rcv_mss = raw.tcpi_rcv_mss ;
+	info->snd_cwnd = raw.tcpi_snd_cwnd ;
+	info->snd_ssthresh = raw.tcpi_snd_ssthresh ;
+	info->unacked = raw.tcpi_unacked ;
+	info->lost = raw.tcpi_lost ;
+	info->retrans = raw.tcpi_retrans ;
+	info->total_retrans = raw.tcpi_total_retrans ;
+	info->last_data_sent_ms = raw.tcpi_last_data_sent ;
+	info->last_data_recv_ms = raw.tcpi_last_data_recv ;
+}
+
+posicxx::TcpInfo posicxx::get_tcp_info(int sockfd) noexcept(false)
+{
+	TcpInfo info ;
+	std::error_code ec ;
+	posicxx::get_tcp_info(sockfd, &info, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return info ;
+}
+
+constexpr size_t posicxx::TcpSampler::Histogram::buckets ;
+
+posicxx::TcpSampler::Histogram::Histogram() noexcept
+{
+	this->reset() ;
+}
+
+void posicxx::TcpSampler::Histogram::record(uint64_t value) noexcept
+{
+	const size_t bucket = value == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(value)) ;
+	this->_counts[bucket].fetch_add(1, std::memory_order_relaxed) ;
+}
+
+uint64_t posicxx::TcpSampler::Histogram::count(size_t bucket) const noexcept
+{
+	return this->_counts[bucket].load(std::memory_order_relaxed) ;
+}
+
+uint64_t posicxx::TcpSampler::Histogram::total() const noexcept
+{
+	uint64_t total = 0 ;
+	for(size_t i = 0 ; i < buckets ; ++i)
+	{
+		total += this->count(i) ;
+	}
+	return total ;
+}
+
+uint64_t posicxx::TcpSampler::Histogram::percentile(double q) const noexcept
+{
+	uint64_t counts[buckets] ;
+	uint64_t total = 0 ;
+	for(size_t i = 0 ; i < buckets ; ++i)
+	{
+		counts[i] = this->count(i) ;
+		total += counts[i] ;
+	}
+	if(total == 0)
+	{
+		return 0 ;
+	}
+
+	const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1 ;
+	uint64_t seen = 0 ;
+	for(size_t i = 0 ; i < buckets ; ++i)
+	{
+		seen += counts[i] ;
+		if(seen >= rank)
+		{
+			/* bucket i holds values below 2^i; the last one runs to the top of the range */
+			return i == 0 ? 1 : (i == 64 ? UINT64_MAX : uint64_t(1) << i) ;
+		}
+	}
+	return UINT64_MAX ;
+}
+
+void posicxx::TcpSampler::Histogram::reset() noexcept
+{
+	for(std::atomic<uint64_t>& count : this->_counts)
+	{
+		count.store(0, std::memory_order_relaxed) ;
+	}
+}
+
+posicxx::TcpSampler::TcpSampler(size_t capacity) noexcept(false) : _capacity(capacity), _slots(new std::atomic<int>[capacity]), _rtt(), _cwnd(), _retrans(), _samples(0)
+{
+	for(size_t i = 0 ; i < capacity ; ++i)
+	{
+		this->_slots[i].store(-1, std::memory_order_relaxed) ;
+	}
+}
+
+bool posicxx::TcpSampler::add(int sockfd) noexcept
+{
+	for(size_t i = 0 ; i < this->_capacity ; ++i)
+	{
+		int empty = -1 ;
+		if(this->_slots[i].load(std::memory_order_relaxed) == -1 && this->_slots[i].compare_exchange_strong(empty, sockfd, std::memory_order_acq_rel))
+		{
+			return true ;
+		}
+	}
+	return false ;
+}
+
+bool posicxx::TcpSampler::remove(int sockfd) noexcept
+{
+	const int busy = -2 - sockfd ;
+	for(size_t i = 0 ; i < this->_capacity ; ++i)
+	{
+		int current = this->_slots[i].load(std::memory_order_acquire) ;
+		while(current == sockfd || current == busy)
+		{
+			/* while sample() reads this connection the slot holds busy, & only sample() puts sockfd back */
+			int expected = sockfd ;
+			if(current == sockfd && this->_slots[i].compare_exchange_strong(expected, -1, std::memory_order_acq_rel))
+			{
+				return true ;
+			}
+			::sched_yield() ;
+			current = this->_slots[i].load(std::memory_order_acquire) ;
+		}
+	}
+	return false ;
+}
+
+size_t posicxx::TcpSampler::sample() noexcept
+{
+	size_t sampled = 0 ;
+	for(size_t i = 0 ; i < this->_capacity ; ++i)
+	{
+		int fd = this->_slots[i].load(std::memory_order_relaxed) ;
+		if(fd < 0 || !this->_slots[i].compare_exchange_strong(fd, -2 - fd, std::memory_order_acq_rel))
+		{
+			continue ; // empty, or removed meanwhile
+		}
+
+		TcpInfo info ;
+		std::error_code ec ;
+		posicxx::get_tcp_info(fd, &info, ec) ;
+		this->_slots[i].store(fd, std::memory_order_release) ;
+		if(ec)
+		{
+			continue ;
+		}
+
+		this->_rtt.record(info.rtt_us) ;
+		this->_cwnd.record(info.snd_cwnd) ;
+		this->_retrans.record(info.total_retrans) ;
+		++sampled ;
+	}
+
+	this->_samples.fetch_add(sampled, std::memory_order_relaxed) ;
+	return sampled ;
+}
+
+void posicxx::TcpSampler::run(unsigned interval_ms, const std::atomic<bool>& running) noexcept
+{
+	while(running.load(std::memory_order_acquire))
+	{
+		this->sample() ;
+
+		struct timespec interval ;
+		interval.tv_sec = interval_ms / 1000 ;
+		interval.tv_nsec = static_cast<long>(interval_ms % 1000) * 1000000 ;
+		::nanosleep(&interval, nullptr) ;
+	}
+}
+
+const posicxx::TcpSampler::Histogram& posicxx::TcpSampler::rtt() const noexcept
+{
+	return this->_rtt ;
+}
+
+const posicxx::TcpSampler::Histogram& posicxx::TcpSampler::cwnd() const noexcept
+{
+	return this->_cwnd ;
+}
+
+const posicxx::TcpSampler::Histogram& posicxx::TcpSampler::retrans() const noexcept
+{
+	return this->_retrans ;
+}
+
+uint64_t posicxx::TcpSampler::samples() const noexcept
+{
+	return this->_samples.load(std::memory_order_relaxed) ;
+}
+
+void posicxx::TcpSampler::reset() noexcept
+{
+	this->_rtt.reset() ;
+	this->_cwnd.reset() ;
+	this->_retrans.reset() ;
+	this->_samples.store(0, std::memory_order_relaxed) ;
+}
+
+#endif // #ifdef TCP_INFO
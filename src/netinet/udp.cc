@@ -0,0 +1,89 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+#include <cstring>
+
+#include "netinet/udp.hh"
+#include "sys/socket.hh"
+
+/**
+ * @brief netinet/udp.cc - file serves as CXX definitions of UDP protocol functionality, containing the fancy interface
+ */
+
+#if defined(UDP_SEGMENT) && defined(UDP_GRO)
+
+void posicxx::set_udp_gro(int sockfd, bool enable) noexcept(false)
+{
+	const int value = enable ? 1 : 0 ;
+	posicxx::setsockopt(sockfd, SOL_UDP, UDP_GRO, &value, sizeof(value)) ;
+}
+
+void posicxx::set_udp_segment(int sockfd, uint16_t segment_size) noexcept(false)
+{
+	const int value = segment_size ;
+	posicxx::setsockopt(sockfd, SOL_UDP, UDP_SEGMENT, &value, sizeof(value)) ;
+}
+
+ssize_t posicxx::send_segmented(int sockfd, const struct iovec* iov, size_t iovlen, uint16_t segment_size, const struct sockaddr* addr, socklen_t addrlen, int flags) noexcept(false)
+{
+	union {
+		char buf[CMSG_SPACE(sizeof(uint16_t))] ;
+		struct cmsghdr align ;
+	} control ;
+	std::memset(&control, 0, sizeof(control)) ;
+
+	struct msghdr msg{} ;
+	msg.msg_name = const_cast<struct sockaddr*>(addr) ;
+	msg.msg_namelen = addr != nullptr ? addrlen : 0 ;
+	msg.msg_iov = const_cast<struct iovec*>(iov) ;
+	msg.msg_iovlen = iovlen ;
+	msg.msg_control = control.buf ;
+	msg.msg_controllen = sizeof(control.buf) ;
+
+	struct cmsghdr* const cmsg = CMSG_FIRSTHDR(&msg) ;
+	cmsg->cmsg_level = SOL_UDP ;
+	cmsg->cmsg_type = UDP_SEGMENT ;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t)) ;
+	std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size)) ;
+
+	return posicxx::sendmsg(sockfd, &msg, flags) ;
+}
+
+ssize_t posicxx::recv_coalesced(int sockfd, void* buf, size_t len, uint16_t* segment_size, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false)
+{
+	union {
+		char buf[CMSG_SPACE(sizeof(int))] ;
+		struct cmsghdr align ;
+	} control ;
+
+	struct iovec iov{buf, len} ;
+	struct msghdr msg{} ;
+	msg.msg_name = addr ;
+	msg.msg_namelen = addr != nullptr && addrlen != nullptr ? *addrlen : 0 ;
+	msg.msg_iov = &iov ;
+	msg.msg_iovlen = 1 ;
+	msg.msg_control = control.buf ;
+	msg.msg_controllen = sizeof(control.buf) ;
+
+	const ssize_t received = posicxx::recvmsg(sockfd, &msg, flags) ;
+
+	if(addr != nullptr && addrlen != nullptr)
+	{
+		*addrlen = msg.msg_namelen ;
+	}
+
+	*segment_size = static_cast<uint16_t>(received) ;
+	for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg) ; cmsg != nullptr ; cmsg = CMSG_NXTHDR(&msg, cmsg))
+	{
+		if(cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+		{
+			int gso_size ; // the kernel reports it as an int, unlike the uint16_t given to UDP_SEGMENT
+			std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size)) ;
+			*segment_size = static_cast<uint16_t>(gso_size) ;
+		}
+	}
+
+	return received ;
+}
+
+#endif // #if defined(UDP_SEGMENT) && defined(UDP_GRO)
@@ -0,0 +1,171 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "sys/epoll.hh"
+
+/**
+ * @brief sys/epoll.cc - file serves as CXX definitions of Linux's I/O event notification facility, containing the minimal wrapper, fancy interface and resource manager
+ */
+
+int posicxx::epoll_create1(int flags) noexcept(false)
+{
+	const int epfd = ::epoll_create1(flags) ;
+	if(epfd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return epfd ;
+}
+
+void posicxx::epoll_ctl(int epfd, int op, int fd, struct epoll_event* event) noexcept(false)
+{
+	if(::epoll_ctl(epfd, op, fd, event) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+int posicxx::epoll_wait(int epfd, struct epoll_event* events, int maxevents, int timeout) noexcept(false)
+{
+	const int ready = ::epoll_wait(epfd, events, maxevents, timeout) ;
+	if(ready < 0)
+	{
+		if(errno == EINTR)
+		{
+			return 0 ;
+		}
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return ready ;
+}
+
+posicxx::Reactor::Reactor(size_t max_events) noexcept(false) : _epfd(posicxx::epoll_create1(EPOLL_CLOEXEC)), _wakefd(-1), _stopped(false), _handlers(), _removed(), _events(max_events == 0 ? 1 : max_events)
+{
+	this->_wakefd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) ;
+	if(this->_wakefd < 0)
+	{
+		const int err = errno ;
+		::close(this->_epfd) ;
+		throw std::system_error(err, std::generic_category()) ;
+	}
+
+	try
+	{
+		this->_ctl(EPOLL_CTL_ADD, this->_wakefd, EPOLLIN, nullptr) ;
+	}
+	catch(...)
+	{
+		::close(this->_wakefd) ;
+		::close(this->_epfd) ;
+		throw ;
+	}
+}
+
+void posicxx::Reactor::_ctl(int op, int fd, uint32_t events, Handler* handler) noexcept(false)
+{
+	struct epoll_event event{} ;
+	event.events = events | EPOLLET ;
+	event.data.ptr = handler ; // NULL marks the wake-up eventfd
+	posicxx::epoll_ctl(this->_epfd, op, fd, &event) ;
+}
+
+void posicxx::Reactor::add(int fd, uint32_t events, Callback callback) noexcept(false)
+{
+	if(this->_handlers.count(fd) != 0)
+	{
+		throw std::system_error(EEXIST, std::generic_category()) ;
+	}
+
+	std::unique_ptr<Handler> handler(new Handler{fd, std::move(callback)}) ;
+	this->_ctl(EPOLL_CTL_ADD, fd, events, handler.get()) ;
+	this->_handlers.emplace(fd, std::move(handler)) ;
+}
+
+void posicxx::Reactor::modify(int fd, uint32_t events) noexcept(false)
+{
+	const auto it = this->_handlers.find(fd) ;
+	if(it == this->_handlers.end())
+	{
+		throw std::system_error(ENOENT, std::generic_category()) ;
+	}
+
+	this->_ctl(EPOLL_CTL_MOD, fd, events, it->second.get()) ;
+}
+
+void posicxx::Reactor::remove(int fd) noexcept(false)
+{
+	const auto it = this->_handlers.find(fd) ;
+	if(it == this->_handlers.end())
+	{
+		throw std::system_error(ENOENT, std::generic_category()) ;
+	}
+
+	posicxx::epoll_ctl(this->_epfd, EPOLL_CTL_DEL, fd, nullptr) ;
+
+	/* events for it may still be queued further along the batch being dispatched - keep it alive, but disarmed, until the batch is done */
+	it->second->fd = -1 ;
+	this->_removed.push_back(std::move(it->second)) ;
+	this->_handlers.erase(it) ;
+}
+
+size_t posicxx::Reactor::run_once(int timeout) noexcept(false)
+{
+	this->_removed.clear() ;
+
+	const int ready = posicxx::epoll_wait(this->_epfd, this->_events.data(), static_cast<int>(this->_events.size()), timeout) ;
+
+	size_t dispatched = 0 ;
+	for(int i = 0 ; i < ready ; ++i)
+	{
+		Handler* const handler = static_cast<Handler*>(this->_events[static_cast<size_t>(i)].data.ptr) ;
+		if(handler == nullptr)
+		{
+			uint64_t count ;
+			if(::read(this->_wakefd, &count, sizeof(count)) < 0)
+			{
+				// EAGAIN, the counter was already drained
+			}
+			continue ;
+		}
+		if(handler->fd < 0)
+		{
+			continue ; // removed by an earlier callback in this batch
+		}
+
+		handler->callback(this->_events[static_cast<size_t>(i)].events) ;
+		++dispatched ;
+	}
+
+	this->_removed.clear() ;
+
+	return dispatched ;
+}
+
+void posicxx::Reactor::run() noexcept(false)
+{
+	while(!this->_stopped.exchange(false, std::memory_order_acq_rel)) // consumes the stop request, so the reactor may be run again
+	{
+		this->run_once(-1) ;
+	}
+}
+
+void posicxx::Reactor::stop() noexcept
+{
+	this->_stopped.store(true, std::memory_order_release) ;
+
+	const uint64_t one = 1 ;
+	if(::write(this->_wakefd, &one, sizeof(one)) < 0)
+	{
+		// only fails if the counter is saturated, in which case a wake-up is pending anyway
+	}
+}
+
+posicxx::Reactor::~Reactor() noexcept
+{
+	::close(this->_wakefd) ;
+	::close(this->_epfd) ;
+}
@@ -0,0 +1,179 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sys/mman.hh"
+
+/**
+ * @brief sys/mman.cc - file serves as CXX definitions of POSIX memory management functionality, containing the minimal wrapper, fancy interface and resource manager
+ */
+
+void* posicxx::mmap(void* addr, size_t len, int prot, int flags, int fildes, off_t off) noexcept(false)
+{
+	void* const mapping = ::mmap(addr, len, prot, flags, fildes, off) ;
+	if(mapping == MAP_FAILED)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return mapping ;
+}
+
+void posicxx::mprotect(void* addr, size_t len, int prot) noexcept(false)
+{
+	if(::mprotect(addr, len, prot) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+#ifdef __linux__
+
+void* posicxx::mremap(void* old_address, size_t old_size, size_t new_size, int flags) noexcept(false)
+{
+	void* const mapping = ::mremap(old_address, old_size, new_size, flags) ;
+	if(mapping == MAP_FAILED)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return mapping ;
+}
+
+#endif // #ifdef __linux__
+
+void posicxx::msync(void* addr, size_t len, int flags) noexcept(false)
+{
+	if(::msync(addr, len, flags) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+void posicxx::munmap(void* addr, size_t len) noexcept(false)
+{
+	if(::munmap(addr, len) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+void posicxx::posix_madvise(void* addr, size_t len, int advice) noexcept(false)
+{
+	const int rmadvise = ::posix_madvise(addr, len, advice) ; // returns the error number rather than setting errno
+	if(rmadvise != 0)
+	{
+		throw std::system_error(rmadvise, std::generic_category()) ;
+	}
+}
+
+namespace {
+
+	size_t page_round(const size_t len) noexcept
+	{
+		static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE)) ;
+		return (len + page - 1) / page * page ;
+	}
+
+}
+
+posicxx::GrowableMapping::GrowableMapping(int fd, size_t reserve, size_t chunk, int prot) noexcept(false) : _fd(fd), _base(nullptr), _reserved(page_round(reserve)), _chunk(page_round(chunk == 0 ? 1 : chunk)), _size(0), _mapped(0), _prot(prot)
+{
+	struct stat st ;
+	if(::fstat(fd, &st) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	if(static_cast<size_t>(st.st_size) > this->_reserved)
+	{
+		throw std::system_error(ENOMEM, std::generic_category()) ;
+	}
+
+	/* address space only - MAP_NORESERVE & PROT_NONE mean no memory is committed for the untouched remainder */
+	this->_base = static_cast<char*>(posicxx::mmap(nullptr, this->_reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)) ;
+
+	try
+	{
+		this->_map(static_cast<size_t>(st.st_size)) ;
+	}
+	catch(...)
+	{
+		::munmap(this->_base, this->_reserved) ;
+		throw ;
+	}
+}
+
+void posicxx::GrowableMapping::_map(size_t size) noexcept(false)
+{
+	const size_t mapped = page_round(size) ;
+	if(mapped > this->_mapped)
+	{
+		posicxx::mmap(this->_base + this->_mapped, mapped - this->_mapped, this->_prot, MAP_SHARED | MAP_FIXED, this->_fd, static_cast<off_t>(this->_mapped)) ;
+		this->_mapped = mapped ;
+	}
+	this->_size = size ;
+}
+
+char* posicxx::GrowableMapping::data() const noexcept
+{
+	return this->_base ;
+}
+
+size_t posicxx::GrowableMapping::size() const noexcept
+{
+	return this->_size ;
+}
+
+size_t posicxx::GrowableMapping::reserved() const noexcept
+{
+	return this->_reserved ;
+}
+
+void posicxx::GrowableMapping::grow(size_t size) noexcept(false)
+{
+	if(size <= this->_size)
+	{
+		return ;
+	}
+	if(size > this->_reserved)
+	{
+		throw std::system_error(ENOMEM, std::generic_category()) ;
+	}
+
+	size_t target = (size + this->_chunk - 1) / this->_chunk * this->_chunk ;
+	if(target > this->_reserved)
+	{
+		target = this->_reserved ;
+	}
+
+	/* allocating up front turns a full disk into an error here, rather than SIGBUS on first touch of the page */
+	const int rfallocate = ::posix_fallocate(this->_fd, static_cast<off_t>(this->_size), static_cast<off_t>(target - this->_size)) ;
+	if(rfallocate != 0)
+	{
+		if(rfallocate != EOPNOTSUPP && rfallocate != EINVAL)
+		{
+			throw std::system_error(rfallocate, std::generic_category()) ;
+		}
+		if(::ftruncate(this->_fd, static_cast<off_t>(target)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+	}
+
+	this->_map(target) ;
+}
+
+void posicxx::GrowableMapping::sync(int flags) noexcept(false)
+{
+	if(this->_mapped != 0)
+	{
+		posicxx::msync(this->_base, this->_mapped, flags) ;
+	}
+}
+
+posicxx::GrowableMapping::~GrowableMapping() noexcept
+{
+	::munmap(this->_base, this->_reserved) ;
+}
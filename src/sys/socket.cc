@@ -1,6 +1,16 @@
 #include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
 
+#include <algorithm>
+#include <exception>
 #include <system_error>
+#include <utility>
+#include <cstring>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#include <linux/filter.h>
+#endif // #ifdef __linux__
 
 #include "sys/socket.hh"
 
@@ -18,6 +28,34 @@ int posicxx::accept(int sockfd, struct sockaddr* addr, socklen_t* addrlen) noexc
 	return fd ;
 }
 
+int posicxx::accept(int sockfd, struct sockaddr* addr, socklen_t* addrlen, std::error_code& ec) noexcept
+{
+	const int fd = ::accept(sockfd, addr, addrlen) ;
+	ec = fd < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return fd ;
+}
+
+#ifdef __linux__
+
+int posicxx::accept4(int sockfd, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false) 
+{
+	const int fd = ::accept4(sockfd, addr, addrlen, flags) ;
+	if(fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return fd ;
+}
+
+int posicxx::accept4(int sockfd, struct sockaddr* addr, socklen_t* addrlen, int flags, std::error_code& ec) noexcept
+{
+	const int fd = ::accept4(sockfd, addr, addrlen, flags) ;
+	ec = fd < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return fd ;
+}
+
+#endif // #ifdef __linux__
+
 void posicxx::bind(int sockfd, const struct sockaddr* addr, socklen_t addrlen) noexcept(false) 
 {
 	if(::bind(sockfd, addr, addrlen) != 0)
@@ -76,6 +114,13 @@ ssize_t posicxx::recv(int sockfd, void* buf, size_t len, int flags) noexcept(fal
 	return len2 ;
 }
 
+ssize_t posicxx::recv(int sockfd, void* buf, size_t len, int flags, std::error_code& ec) noexcept
+{
+	const ssize_t len2 = ::recv(sockfd, buf, len, flags) ;
+	ec = len2 < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return len2 ;
+}
+
 ssize_t posicxx::recvfrom(int sockfd, void* buf, size_t len, int flags, struct sockaddr* src_addr, socklen_t* addrlen) noexcept(false) 
 {
 	const ssize_t len2 = ::recvfrom(sockfd, buf, len, flags, src_addr, addrlen) ;
@@ -86,6 +131,27 @@ ssize_t posicxx::recvfrom(int sockfd, void* buf, size_t len, int flags, struct s
 	return len2 ;
 }
 
+#ifdef __linux__
+
+int posicxx::recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, struct timespec* timeout) noexcept(false)
+{
+	const int count = ::recvmmsg(sockfd, msgvec, vlen, flags, timeout) ;
+	if(count < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return count ;
+}
+
+int posicxx::recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, struct timespec* timeout, std::error_code& ec) noexcept
+{
+	const int count = ::recvmmsg(sockfd, msgvec, vlen, flags, timeout) ;
+	ec = count < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return count ;
+}
+
+#endif // #ifdef __linux__
+
 ssize_t posicxx::recvmsg(int sockfd, struct msghdr* msg, int flags) noexcept(false) 
 {
 	const ssize_t len = ::recvmsg(sockfd, msg, flags) ;
@@ -96,6 +162,13 @@ ssize_t posicxx::recvmsg(int sockfd, struct msghdr* msg, int flags) noexcept(fal
 	return len ;
 }
 
+ssize_t posicxx::recvmsg(int sockfd, struct msghdr* msg, int flags, std::error_code& ec) noexcept
+{
+	const ssize_t len = ::recvmsg(sockfd, msg, flags) ;
+	ec = len < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return len ;
+}
+
 ssize_t posicxx::send(int sockfd, const void* buf, size_t len, int flags)
 {
 	const ssize_t len2 = ::send(sockfd, buf, len, flags) ;
@@ -106,6 +179,13 @@ ssize_t posicxx::send(int sockfd, const void* buf, size_t len, int flags)
 	return len2 ;
 }
 
+ssize_t posicxx::send(int sockfd, const void* buf, size_t len, int flags, std::error_code& ec) noexcept
+{
+	const ssize_t len2 = ::send(sockfd, buf, len, flags) ;
+	ec = len2 < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return len2 ;
+}
+
 ssize_t posicxx::sendto(int sockfd, const void* buf, size_t len, int flags, const struct sockaddr* dest_addr, socklen_t addrlen) noexcept(false) 
 {
 	const ssize_t len2 = ::sendto(sockfd, buf, len, flags, dest_addr, addrlen) ;
@@ -116,6 +196,27 @@ ssize_t posicxx::sendto(int sockfd, const void* buf, size_t len, int flags, cons
 	return len2 ;
 }
 
+#ifdef __linux__
+
+int posicxx::sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags) noexcept(false)
+{
+	const int count = ::sendmmsg(sockfd, msgvec, vlen, flags) ;
+	if(count < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	return count ;
+}
+
+int posicxx::sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned vlen, int flags, std::error_code& ec) noexcept
+{
+	const int count = ::sendmmsg(sockfd, msgvec, vlen, flags) ;
+	ec = count < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return count ;
+}
+
+#endif // #ifdef __linux__
+
 ssize_t posicxx::sendmsg(int sockfd, const struct msghdr* msg, int flags) noexcept(false) 
 {
 	const ssize_t len = ::sendmsg(sockfd, msg, flags) ;
@@ -126,6 +227,13 @@ ssize_t posicxx::sendmsg(int sockfd, const struct msghdr* msg, int flags) noexce
 	return len ;
 }
 
+ssize_t posicxx::sendmsg(int sockfd, const struct msghdr* msg, int flags, std::error_code& ec) noexcept
+{
+	const ssize_t len = ::sendmsg(sockfd, msg, flags) ;
+	ec = len < 0 ? std::error_code(errno, std::generic_category()) : std::error_code() ;
+	return len ;
+}
+
 void posicxx::setsockopt(int sockfd, int level, int optname, const void* optval, socklen_t optlen) noexcept(false) 
 {
 	if(::setsockopt(sockfd, level, optname, optval, optlen) != 0)
@@ -169,3 +277,1288 @@ void posicxx::socketpair(int domain, int type, int protocol, int sv[2]) noexcept
 		throw std::system_error(errno, std::generic_category()) ;
 	}
 }
+
+#ifdef __linux__
+
+posicxx::DatagramBatch::DatagramBatch(size_t slots, size_t slot_size) noexcept(false) : _slots(slots), _slot_size(slot_size), _count(0), _buffers(new char[slots * slot_size]), _headers(new struct mmsghdr[slots]()), _iovecs(new struct iovec[slots]()), _addrs(new struct sockaddr_storage[slots]()), _datagrams(new Datagram[slots]())
+{
+	for(size_t i = 0 ; i < slots ; ++i)
+	{
+		this->_iovecs[i].iov_base = this->_buffers.get() + i * slot_size ;
+		this->_headers[i].msg_hdr.msg_iov = &this->_iovecs[i] ;
+		this->_headers[i].msg_hdr.msg_iovlen = 1 ;
+	}
+}
+
+void posicxx::DatagramBatch::_arm(size_t count) noexcept
+{
+	/* recvmmsg overwrites the lengths, so they're restored before every call */
+	for(size_t i = 0 ; i < count ; ++i)
+	{
+		this->_iovecs[i].iov_len = this->_slot_size ;
+		this->_headers[i].msg_hdr.msg_name = &this->_addrs[i] ;
+		this->_headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage) ;
+		this->_headers[i].msg_hdr.msg_flags = 0 ;
+	}
+}
+
+void posicxx::DatagramBatch::_collect(size_t count) noexcept
+{
+	for(size_t i = 0 ; i < count ; ++i)
+	{
+		const struct msghdr& hdr = this->_headers[i].msg_hdr ;
+		const size_t received = this->_headers[i].msg_len < this->_slot_size ? this->_headers[i].msg_len : this->_slot_size ;
+
+		/* left addressed to the sender & sized to the payload, so a received batch can be sent straight back */
+		this->_iovecs[i].iov_len = received ;
+		this->_datagrams[i] = Datagram{static_cast<char*>(this->_iovecs[i].iov_base), received, reinterpret_cast<const struct sockaddr*>(&this->_addrs[i]), hdr.msg_namelen, hdr.msg_flags} ;
+	}
+	this->_count = count ;
+}
+
+size_t posicxx::DatagramBatch::recv(int sockfd, int flags) noexcept(false)
+{
+	this->_arm(this->_slots) ;
+	const int count = posicxx::recvmmsg(sockfd, this->_headers.get(), static_cast<unsigned>(this->_slots), flags, nullptr) ;
+	this->_collect(static_cast<size_t>(count)) ;
+	return this->_count ;
+}
+
+size_t posicxx::DatagramBatch::recv(int sockfd, int flags, std::error_code& ec) noexcept
+{
+	this->_arm(this->_slots) ;
+	const int count = posicxx::recvmmsg(sockfd, this->_headers.get(), static_cast<unsigned>(this->_slots), flags, nullptr, ec) ;
+	this->_collect(count < 0 ? 0 : static_cast<size_t>(count)) ;
+	return this->_count ;
+}
+
+void posicxx::DatagramBatch::push(const void* data, size_t len, const struct sockaddr* addr, socklen_t addrlen) noexcept(false)
+{
+	if(this->_count == this->_slots)
+	{
+		throw std::system_error(ENOBUFS, std::generic_category()) ;
+	}
+	if(len > this->_slot_size || (addr != nullptr && addrlen > sizeof(struct sockaddr_storage)))
+	{
+		throw std::system_error(EMSGSIZE, std::generic_category()) ;
+	}
+
+	const size_t i = this->_count++ ;
+	std::memcpy(this->_iovecs[i].iov_base, data, len) ;
+	this->_iovecs[i].iov_len = len ;
+
+	struct msghdr& hdr = this->_headers[i].msg_hdr ;
+	if(addr != nullptr)
+	{
+		std::memcpy(&this->_addrs[i], addr, addrlen) ;
+		hdr.msg_name = &this->_addrs[i] ;
+		hdr.msg_namelen = addrlen ;
+	}
+	else
+	{
+		hdr.msg_name = nullptr ;
+		hdr.msg_namelen = 0 ;
+	}
+	hdr.msg_flags = 0 ;
+
+	this->_datagrams[i] = Datagram{static_cast<char*>(this->_iovecs[i].iov_base), len, static_cast<const struct sockaddr*>(hdr.msg_name), hdr.msg_namelen, 0} ;
+}
+
+size_t posicxx::DatagramBatch::send(int sockfd, int flags, size_t first) noexcept(false)
+{
+	if(first >= this->_count)
+	{
+		return 0 ;
+	}
+	return static_cast<size_t>(posicxx::sendmmsg(sockfd, this->_headers.get() + first, static_cast<unsigned>(this->_count - first), flags)) ;
+}
+
+size_t posicxx::DatagramBatch::send(int sockfd, int flags, size_t first, std::error_code& ec) noexcept
+{
+	if(first >= this->_count)
+	{
+		ec.clear() ;
+		return 0 ;
+	}
+	const int count = posicxx::sendmmsg(sockfd, this->_headers.get() + first, static_cast<unsigned>(this->_count - first), flags, ec) ;
+	return count < 0 ? 0 : static_cast<size_t>(count) ;
+}
+
+void posicxx::DatagramBatch::clear() noexcept
+{
+	this->_count = 0 ;
+}
+
+size_t posicxx::DatagramBatch::size() const noexcept
+{
+	return this->_count ;
+}
+
+size_t posicxx::DatagramBatch::capacity() const noexcept
+{
+	return this->_slots ;
+}
+
+const posicxx::DatagramBatch::Datagram& posicxx::DatagramBatch::operator[](size_t index) const noexcept
+{
+	return this->_datagrams[index] ;
+}
+
+const posicxx::DatagramBatch::Datagram* posicxx::DatagramBatch::begin() const noexcept
+{
+	return this->_datagrams.get() ;
+}
+
+const posicxx::DatagramBatch::Datagram* posicxx::DatagramBatch::end() const noexcept
+{
+	return this->_datagrams.get() + this->_count ;
+}
+
+#endif // #ifdef __linux__
+
+#ifdef SO_REUSEPORT
+
+posicxx::ShardedListener::ShardedListener(const struct sockaddr* addr, socklen_t addrlen, size_t shards, int backlog, int type, bool steer) noexcept(false) : _count(0), _shards(new Shard[shards == 0 ? 1 : shards])
+{
+	struct sockaddr_storage bound ;
+	if(addrlen > sizeof(bound))
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+	std::memcpy(&bound, addr, addrlen) ;
+
+	try
+	{
+		for(size_t i = 0 ; i < (shards == 0 ? 1 : shards) ; ++i)
+		{
+			this->_shards[i].fd = posicxx::socket(addr->sa_family, type, 0) ;
+			this->_shards[i].accepted.store(0, std::memory_order_relaxed) ;
+			++this->_count ;
+
+			const int one = 1 ;
+			posicxx::setsockopt(this->_shards[i].fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) ;
+			posicxx::bind(this->_shards[i].fd, reinterpret_cast<const struct sockaddr*>(&bound), addrlen) ;
+
+			if(i == 0)
+			{
+				/* resolves a wildcard port, so the remaining shards join the same group */
+				socklen_t boundlen = sizeof(bound) ;
+				posicxx::getsockname(this->_shards[0].fd, reinterpret_cast<struct sockaddr*>(&bound), &boundlen) ;
+				addrlen = boundlen ;
+			}
+		}
+
+		for(size_t i = 0 ; i < this->_count ; ++i)
+		{
+			posicxx::listen(this->_shards[i].fd, backlog) ;
+		}
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+		if(steer)
+		{
+			/* the program returns an index into the group's sockets, which are ordered by when they started listening: A = cpu ; A %= shards ; return A
+			 * attached once every shard listens - attaching earlier gives the first socket a group of its own, & listen() then fails with EADDRINUSE */
+			struct sock_filter code[] = {
+				{BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+				{BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(this->_count)},
+				{BPF_RET | BPF_A, 0, 0, 0},
+			} ;
+			struct sock_fprog prog = {static_cast<unsigned short>(sizeof(code) / sizeof(code[0])), code} ;
+			posicxx::setsockopt(this->_shards[0].fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) ;
+		}
+#else
+		if(steer)
+		{
+			throw std::system_error(ENOPROTOOPT, std::generic_category()) ;
+		}
+#endif // #ifdef SO_ATTACH_REUSEPORT_CBPF
+	}
+	catch(...)
+	{
+		this->_close() ;
+		throw ;
+	}
+}
+
+void posicxx::ShardedListener::_close() noexcept
+{
+	for(size_t i = 0 ; i < this->_count ; ++i)
+	{
+		::close(this->_shards[i].fd) ;
+	}
+	this->_count = 0 ;
+}
+
+size_t posicxx::ShardedListener::size() const noexcept
+{
+	return this->_count ;
+}
+
+int posicxx::ShardedListener::fd(size_t shard) const noexcept
+{
+	return this->_shards[shard].fd ;
+}
+
+int posicxx::ShardedListener::accept(size_t shard, struct sockaddr* addr, socklen_t* addrlen) noexcept(false)
+{
+	const int fd = posicxx::accept(this->_shards[shard].fd, addr, addrlen) ;
+	this->_shards[shard].accepted.fetch_add(1, std::memory_order_relaxed) ;
+	return fd ;
+}
+
+int posicxx::ShardedListener::accept(size_t shard, struct sockaddr* addr, socklen_t* addrlen, std::error_code& ec) noexcept
+{
+	const int fd = posicxx::accept(this->_shards[shard].fd, addr, addrlen, ec) ;
+	if(fd >= 0)
+	{
+		this->_shards[shard].accepted.fetch_add(1, std::memory_order_relaxed) ;
+	}
+	return fd ;
+}
+
+#ifdef __linux__
+
+int posicxx::ShardedListener::accept4(size_t shard, struct sockaddr* addr, socklen_t* addrlen, int flags) noexcept(false)
+{
+	const int fd = posicxx::accept4(this->_shards[shard].fd, addr, addrlen, flags) ;
+	this->_shards[shard].accepted.fetch_add(1, std::memory_order_relaxed) ;
+	return fd ;
+}
+
+int posicxx::ShardedListener::accept4(size_t shard, struct sockaddr* addr, socklen_t* addrlen, int flags, std::error_code& ec) noexcept
+{
+	const int fd = posicxx::accept4(this->_shards[shard].fd, addr, addrlen, flags, ec) ;
+	if(fd >= 0)
+	{
+		this->_shards[shard].accepted.fetch_add(1, std::memory_order_relaxed) ;
+	}
+	return fd ;
+}
+
+#endif // #ifdef __linux__
+
+unsigned long long posicxx::ShardedListener::accepted(size_t shard) const noexcept
+{
+	return this->_shards[shard].accepted.load(std::memory_order_relaxed) ;
+}
+
+posicxx::ShardedListener::~ShardedListener() noexcept
+{
+	this->_close() ;
+}
+
+#endif // #ifdef SO_REUSEPORT
+
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+
+namespace {
+
+	/* room for one error-queue message: a TX timestamp & its extended error, or a zerocopy completion */
+	constexpr size_t errqueue_control = CMSG_SPACE(sizeof(struct scm_timestamping)) + CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6)) ;
+
+	/* a TX timestamp comes as a pair: SCM_TIMESTAMPING with the time, then the extended error saying which send & at what point */
+	bool tx_stamp(struct msghdr* msg, posicxx::Timestamp* stamp) noexcept
+	{
+		bool timed = false ;
+		bool keyed = false ;
+		for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg) ; cmsg != nullptr ; cmsg = CMSG_NXTHDR(msg, cmsg))
+		{
+			if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING)
+			{
+				struct scm_timestamping tss ;
+				std::memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss)) ;
+				stamp->kernel = tss.ts[0] ;
+				timed = true ;
+			}
+			else if((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))
+			{
+				struct sock_extended_err err ;
+				std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err)) ;
+				if(err.ee_origin == SO_EE_ORIGIN_TIMESTAMPING && err.ee_errno == ENOMSG)
+				{
+					stamp->id = err.ee_data ;
+					stamp->type = static_cast<int>(err.ee_info) ;
+					keyed = true ;
+				}
+			}
+		}
+
+		if(timed && keyed)
+		{
+			::clock_gettime(CLOCK_REALTIME, &stamp->extracted) ;
+		}
+		return timed && keyed ;
+	}
+
+}
+
+#endif // #if defined(__linux__) && defined(SO_TIMESTAMPING)
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
+posicxx::ZeroCopySender::ZeroCopySender(int sockfd) noexcept(false) : _fd(sockfd), _head(0), _pending(), _copied(0)
+{
+	const int one = 1 ;
+	posicxx::setsockopt(sockfd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) ;
+}
+
+ssize_t posicxx::ZeroCopySender::send(const void* buf, size_t len, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const ssize_t sent = this->send(buf, len, flags, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return sent ;
+}
+
+ssize_t posicxx::ZeroCopySender::send(const void* buf, size_t len, int flags, std::error_code& ec) noexcept(false)
+{
+	const ssize_t sent = ::send(this->_fd, buf, len, flags | MSG_ZEROCOPY) ;
+	if(sent < 0)
+	{
+		ec = std::error_code(errno, std::generic_category()) ;
+		return sent ;
+	}
+	ec = std::error_code() ;
+
+	/* the kernel numbers every successful MSG_ZEROCOPY call, consecutively from 0 */
+	this->_pending.push_back(Pending{buf, static_cast<size_t>(sent), false}) ;
+	return sent ;
+}
+
+size_t posicxx::ZeroCopySender::reap(const Release& release) noexcept(false)
+{
+	return this->_reap(release, nullptr) ;
+}
+
+#ifdef SO_TIMESTAMPING
+
+size_t posicxx::ZeroCopySender::reap(const Release& release, const Stamped& stamped) noexcept(false)
+{
+	return this->_reap(release, &stamped) ;
+}
+
+#endif // #ifdef SO_TIMESTAMPING
+
+size_t posicxx::ZeroCopySender::_reap(const Release& release, const Stamped* stamped) noexcept(false)
+{
+	size_t released = 0 ;
+
+	for(;;)
+	{
+#ifdef SO_TIMESTAMPING
+		alignas(struct cmsghdr) char control[errqueue_control] ;
+#else
+		alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + CMSG_SPACE(sizeof(struct sockaddr_in6))] ;
+#endif // #ifdef SO_TIMESTAMPING
+		struct msghdr msg ;
+		std::memset(&msg, 0, sizeof(msg)) ;
+		msg.msg_control = control ;
+		msg.msg_controllen = sizeof(control) ;
+
+		std::error_code ec ;
+		posicxx::recvmsg(this->_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT, ec) ;
+		if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+		{
+			break ;
+		}
+		if(ec)
+		{
+			throw std::system_error(ec) ;
+		}
+
+#ifdef SO_TIMESTAMPING
+		Timestamp stamp ;
+		if(stamped != nullptr && tx_stamp(&msg, &stamp))
+		{
+			(*stamped)(stamp) ;
+			continue ;
+		}
+#else
+		(void)stamped ;
+#endif // #ifdef SO_TIMESTAMPING
+
+		for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg) ; cmsg != nullptr ; cmsg = CMSG_NXTHDR(&msg, cmsg))
+		{
+			if(!((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)))
+			{
+				continue ;
+			}
+
+			struct sock_extended_err err ;
+			std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err)) ;
+			if(err.ee_origin != SO_EE_ORIGIN_ZEROCOPY || err.ee_errno != 0)
+			{
+				continue ;
+			}
+
+			/* notifications cover an inclusive range [ee_info, ee_data] of send numbers, which may wrap */
+			const uint32_t count = err.ee_data - err.ee_info + 1 ;
+			if(err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+			{
+				this->_copied += count ;
+			}
+
+			for(uint32_t i = 0 ; i < count ; ++i)
+			{
+				const uint32_t index = err.ee_info + i - this->_head ;
+				if(index < this->_pending.size() && !this->_pending[index].done)
+				{
+					this->_pending[index].done = true ;
+					release(this->_pending[index].data, this->_pending[index].size) ;
+					++released ;
+				}
+			}
+		}
+
+		while(!this->_pending.empty() && this->_pending.front().done)
+		{
+			this->_pending.pop_front() ;
+			++this->_head ;
+		}
+	}
+
+	return released ;
+}
+
+size_t posicxx::ZeroCopySender::outstanding() const noexcept
+{
+	size_t count = 0 ;
+	for(const Pending& pending : this->_pending)
+	{
+		count += pending.done ? 0 : 1 ;
+	}
+	return count ;
+}
+
+unsigned long long posicxx::ZeroCopySender::copied() const noexcept
+{
+	return this->_copied ;
+}
+
+#endif // #if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
+posicxx::MessageBuilder::MessageBuilder(struct iovec* iov, size_t iovcap, unsigned char* control, size_t controlcap) noexcept : _iov(iov), _iovcap(iovcap), _control(control), _controlcap(controlcap), _namecap(0)
+{
+	this->clear() ;
+}
+
+void posicxx::MessageBuilder::clear() noexcept
+{
+	std::memset(&this->_msg, 0, sizeof(this->_msg)) ;
+	this->_msg.msg_iov = this->_iov ;
+	this->_namecap = 0 ;
+}
+
+void posicxx::MessageBuilder::name(void* addr, socklen_t addrlen) noexcept
+{
+	this->_msg.msg_name = addr ;
+	this->_namecap = addr != nullptr ? addrlen : 0 ;
+	this->_msg.msg_namelen = this->_namecap ;
+}
+
+void posicxx::MessageBuilder::append(void* base, size_t len) noexcept(false)
+{
+	const size_t count = static_cast<size_t>(this->_msg.msg_iovlen) ;
+	if(count == this->_iovcap)
+	{
+		throw std::system_error(ENOBUFS, std::generic_category()) ;
+	}
+	this->_iov[count].iov_base = base ;
+	this->_iov[count].iov_len = len ;
+	this->_msg.msg_iovlen = count + 1 ;
+}
+
+void posicxx::MessageBuilder::append(const void* base, size_t len) noexcept(false)
+{
+	/* sendmsg only reads through iov_base, which is non-const for the sake of recvmsg */
+	this->append(const_cast<void*>(base), len) ;
+}
+
+void posicxx::MessageBuilder::add_control(int level, int type, const void* data, size_t len) noexcept(false)
+{
+	const size_t used = static_cast<size_t>(this->_msg.msg_controllen) ;
+	if(this->_controlcap - used < CMSG_SPACE(len))
+	{
+		throw std::system_error(ENOBUFS, std::generic_category()) ;
+	}
+
+	/* zeroed so the padding the kernel skips over isn't uninitialized */
+	std::memset(this->_control + used, 0, CMSG_SPACE(len)) ;
+
+	struct cmsghdr cmsg ;
+	std::memset(&cmsg, 0, sizeof(cmsg)) ;
+	cmsg.cmsg_level = level ;
+	cmsg.cmsg_type = type ;
+	cmsg.cmsg_len = CMSG_LEN(len) ;
+	std::memcpy(this->_control + used, &cmsg, sizeof(cmsg)) ;
+	std::memcpy(CMSG_DATA(reinterpret_cast<struct cmsghdr*>(this->_control + used)), data, len) ;
+
+	this->_msg.msg_control = this->_control ;
+	this->_msg.msg_controllen = used + CMSG_SPACE(len) ;
+}
+
+const struct cmsghdr* posicxx::MessageBuilder::find_control(int level, int type) const noexcept
+{
+	for(const struct cmsghdr* cmsg = this->first_control() ; cmsg != nullptr ; cmsg = this->next_control(cmsg))
+	{
+		if(cmsg->cmsg_level == level && cmsg->cmsg_type == type)
+		{
+			return cmsg ;
+		}
+	}
+	return nullptr ;
+}
+
+const struct cmsghdr* posicxx::MessageBuilder::first_control() const noexcept
+{
+	return CMSG_FIRSTHDR(&this->_msg) ;
+}
+
+const struct cmsghdr* posicxx::MessageBuilder::next_control(const struct cmsghdr* cmsg) const noexcept
+{
+	/* CMSG_NXTHDR takes non-const pointers but only reads through them */
+	return CMSG_NXTHDR(const_cast<struct msghdr*>(&this->_msg), const_cast<struct cmsghdr*>(cmsg)) ;
+}
+
+ssize_t posicxx::MessageBuilder::send(int sockfd, int flags) noexcept(false)
+{
+	return posicxx::sendmsg(sockfd, &this->_msg, flags) ;
+}
+
+ssize_t posicxx::MessageBuilder::send(int sockfd, int flags, std::error_code& ec) noexcept
+{
+	return posicxx::sendmsg(sockfd, &this->_msg, flags, ec) ;
+}
+
+ssize_t posicxx::MessageBuilder::recv(int sockfd, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const ssize_t received = this->recv(sockfd, flags, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return received ;
+}
+
+ssize_t posicxx::MessageBuilder::recv(int sockfd, int flags, std::error_code& ec) noexcept
+{
+	this->_msg.msg_control = this->_controlcap != 0 ? this->_control : nullptr ;
+	this->_msg.msg_controllen = this->_controlcap ;
+	this->_msg.msg_namelen = this->_namecap ;
+	this->_msg.msg_flags = 0 ;
+	const ssize_t received = posicxx::recvmsg(sockfd, &this->_msg, flags, ec) ;
+	if(received < 0)
+	{
+		this->_msg.msg_controllen = 0 ;
+	}
+	return received ;
+}
+
+int posicxx::MessageBuilder::flags() const noexcept
+{
+	return this->_msg.msg_flags ;
+}
+
+struct msghdr* posicxx::MessageBuilder::get() noexcept
+{
+	return &this->_msg ;
+}
+
+posicxx::SendQueue::SendQueue(int sockfd, size_t low, size_t high, Pressure pressure, int flags) noexcept : _fd(sockfd), _flags(flags), _low(low), _high(high), _queued(0), _offset(0), _pressured(false), _buffers(), _pressure(std::move(pressure))
+{
+}
+
+bool posicxx::SendQueue::push(const void* data, size_t len, Release release) noexcept(false)
+{
+	this->_buffers.push_back(Buffer{static_cast<const char*>(data), len, std::move(release)}) ;
+	this->_queued += len ;
+
+	if(!this->_pressured && this->_queued >= this->_high)
+	{
+		this->_pressured = true ;
+		if(this->_pressure)
+		{
+			this->_pressure(true) ;
+		}
+	}
+	return !this->_pressured ;
+}
+
+void posicxx::SendQueue::_consume(size_t sent) noexcept(false)
+{
+	this->_queued -= sent ;
+	sent += this->_offset ;
+
+	/* a throwing callback mustn't leave sent buffers queued, so the first exception waits until the queue is consistent */
+	std::exception_ptr failure ;
+	while(!this->_buffers.empty() && sent >= this->_buffers.front().size)
+	{
+		Buffer buffer = std::move(this->_buffers.front()) ;
+		this->_buffers.pop_front() ;
+		sent -= buffer.size ;
+		if(buffer.release)
+		{
+			try
+			{
+				buffer.release(buffer.data, buffer.size) ;
+			}
+			catch(...)
+			{
+				if(!failure)
+				{
+					failure = std::current_exception() ;
+				}
+			}
+		}
+	}
+	this->_offset = sent ;
+
+	if(this->_pressured && this->_queued <= this->_low)
+	{
+		this->_pressured = false ;
+		if(this->_pressure)
+		{
+			this->_pressure(false) ;
+		}
+	}
+
+	if(failure)
+	{
+		std::rethrow_exception(failure) ;
+	}
+}
+
+size_t posicxx::SendQueue::flush() noexcept(false)
+{
+	std::error_code ec ;
+	const size_t sent = this->flush(ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return sent ;
+}
+
+size_t posicxx::SendQueue::flush(std::error_code& ec) noexcept(false)
+{
+	ec = std::error_code() ;
+	size_t total = 0 ;
+
+	while(!this->_buffers.empty())
+	{
+		struct iovec iov[64] ;
+		size_t count = 0 ;
+		for(const Buffer& buffer : this->_buffers)
+		{
+			if(count == 64)
+			{
+				break ;
+			}
+			const size_t skip = count == 0 ? this->_offset : 0 ;
+			iov[count].iov_base = const_cast<char*>(buffer.data + skip) ;
+			iov[count].iov_len = buffer.size - skip ;
+			++count ;
+		}
+
+		struct msghdr msg ;
+		std::memset(&msg, 0, sizeof(msg)) ;
+		msg.msg_iov = iov ;
+		msg.msg_iovlen = count ;
+
+		const ssize_t sent = posicxx::sendmsg(this->_fd, &msg, this->_flags | MSG_DONTWAIT, ec) ;
+		if(ec == std::errc::interrupted)
+		{
+			continue ;
+		}
+		if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+		{
+			ec = std::error_code() ;
+			break ;
+		}
+		if(ec)
+		{
+			break ;
+		}
+
+		total += static_cast<size_t>(sent) ;
+		this->_consume(static_cast<size_t>(sent)) ;
+	}
+
+	return total ;
+}
+
+void posicxx::SendQueue::clear() noexcept(false)
+{
+	this->_consume(this->_queued) ;
+}
+
+size_t posicxx::SendQueue::queued() const noexcept
+{
+	return this->_queued ;
+}
+
+bool posicxx::SendQueue::empty() const noexcept
+{
+	return this->_buffers.empty() ;
+}
+
+bool posicxx::SendQueue::pressured() const noexcept
+{
+	return this->_pressured ;
+}
+
+posicxx::SendQueue::~SendQueue() noexcept
+{
+	try
+	{
+		this->clear() ;
+	}
+	catch(...)
+	{
+		/* every buffer has still been released; there is nobody left to report to */
+	}
+}
+
+constexpr size_t posicxx::SocketProfile::capacity ;
+
+posicxx::SocketProfile::SocketProfile() noexcept : _entries(), _count(0)
+{
+}
+
+void posicxx::SocketProfile::_add(int level, int name, int value) noexcept(false)
+{
+	for(size_t i = 0 ; i < this->_count ; ++i)
+	{
+		if(this->_entries[i].level == level && this->_entries[i].name == name)
+		{
+			this->_entries[i].value = value ;
+			return ;
+		}
+	}
+
+	if(this->_count == capacity)
+	{
+		throw std::system_error(ENOBUFS, std::generic_category()) ;
+	}
+	this->_entries[this->_count++] = Entry{level, name, value} ;
+}
+
+void posicxx::SocketProfile::apply(int sockfd) const noexcept(false)
+{
+	std::error_code ec ;
+	this->apply(sockfd, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+}
+
+size_t posicxx::SocketProfile::apply(int sockfd, std::error_code& ec) const noexcept
+{
+	ec = std::error_code() ;
+	for(size_t i = 0 ; i < this->_count ; ++i)
+	{
+		const Entry& entry = this->_entries[i] ;
+		if(::setsockopt(sockfd, entry.level, entry.name, &entry.value, sizeof(entry.value)) != 0)
+		{
+			ec = std::error_code(errno, std::generic_category()) ;
+			return i ;
+		}
+	}
+	return this->_count ;
+}
+
+size_t posicxx::SocketProfile::size() const noexcept
+{
+	return this->_count ;
+}
+
+posicxx::FrameReader::FrameReader(size_t capacity, Format format, char delimiter) noexcept(false) : _buffer(new char[capacity]), _capacity(capacity), _head(0), _tail(0), _scanned(0), _need(0), _format(format), _delimiter(delimiter)
+{
+}
+
+ssize_t posicxx::FrameReader::fill(int sockfd, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const ssize_t received = this->fill(sockfd, flags, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return received ;
+}
+
+ssize_t posicxx::FrameReader::fill(int sockfd, int flags, std::error_code& ec) noexcept
+{
+	if(this->_need > this->_capacity || (this->_tail - this->_head == this->_capacity))
+	{
+		ec = std::make_error_code(std::errc::message_size) ;
+		return -1 ;
+	}
+
+	/* compacts only once the pending frame can't be completed in the room left behind it */
+	if(this->_tail == this->_capacity || (this->_need != 0 && this->_head + this->_need > this->_capacity))
+	{
+		std::memmove(this->_buffer.get(), this->_buffer.get() + this->_head, this->_tail - this->_head) ;
+		this->_tail -= this->_head ;
+		this->_head = 0 ;
+	}
+
+	const ssize_t received = posicxx::recv(sockfd, this->_buffer.get() + this->_tail, this->_capacity - this->_tail, flags, ec) ;
+	if(received > 0)
+	{
+		this->_tail += static_cast<size_t>(received) ;
+	}
+	return received ;
+}
+
+bool posicxx::FrameReader::next(Frame& frame) noexcept
+{
+	const size_t available = this->_tail - this->_head ;
+	const char* const start = this->_buffer.get() + this->_head ;
+
+	if(this->_format == Format::length_prefixed)
+	{
+		if(available < 4)
+		{
+			this->_need = 0 ;
+			return false ;
+		}
+		const unsigned char* const prefix = reinterpret_cast<const unsigned char*>(start) ;
+		const size_t len = static_cast<size_t>(prefix[0]) << 24 | static_cast<size_t>(prefix[1]) << 16 | static_cast<size_t>(prefix[2]) << 8 | static_cast<size_t>(prefix[3]) ;
+		if(available < 4 + len)
+		{
+			this->_need = 4 + len ;
+			return false ;
+		}
+
+		frame.data = start + 4 ;
+		frame.size = len ;
+		this->_head += 4 + len ;
+	}
+	else
+	{
+		const void* const found = std::memchr(start + this->_scanned, this->_delimiter, available - this->_scanned) ;
+		if(found == nullptr)
+		{
+			this->_scanned = available ;
+			this->_need = 0 ;
+			return false ;
+		}
+
+		frame.data = start ;
+		frame.size = static_cast<size_t>(static_cast<const char*>(found) - start) ;
+		this->_head += frame.size + 1 ;
+		this->_scanned = 0 ;
+	}
+
+	this->_need = 0 ;
+	if(this->_head == this->_tail)
+	{
+		/* an empty buffer rewinds for free, so most streams never need compacting */
+		this->_head = 0 ;
+		this->_tail = 0 ;
+	}
+	return true ;
+}
+
+size_t posicxx::FrameReader::buffered() const noexcept
+{
+	return this->_tail - this->_head ;
+}
+
+constexpr size_t posicxx::FrameWriter::capacity ;
+
+posicxx::FrameWriter::FrameWriter(FrameReader::Format format, char delimiter) noexcept : _first(0), _count(0), _pending(0), _format(format), _delimiter(delimiter)
+{
+}
+
+bool posicxx::FrameWriter::add(const void* data, size_t len) noexcept
+{
+	if(this->_count == capacity * 2 || (this->_format == FrameReader::Format::length_prefixed && len > UINT32_MAX))
+	{
+		return false ;
+	}
+
+	const size_t frame = this->_count / 2 ;
+	struct iovec& payload = this->_iov[this->_count + (this->_format == FrameReader::Format::length_prefixed ? 1 : 0)] ;
+	struct iovec& framing = this->_iov[this->_count + (this->_format == FrameReader::Format::length_prefixed ? 0 : 1)] ;
+
+	payload.iov_base = const_cast<void*>(data) ;
+	payload.iov_len = len ;
+	if(this->_format == FrameReader::Format::length_prefixed)
+	{
+		const uint32_t n = static_cast<uint32_t>(len) ;
+		this->_prefixes[frame][0] = static_cast<unsigned char>(n >> 24) ;
+		this->_prefixes[frame][1] = static_cast<unsigned char>(n >> 16) ;
+		this->_prefixes[frame][2] = static_cast<unsigned char>(n >> 8) ;
+		this->_prefixes[frame][3] = static_cast<unsigned char>(n) ;
+		framing.iov_base = this->_prefixes[frame] ;
+		framing.iov_len = 4 ;
+	}
+	else
+	{
+		framing.iov_base = &this->_delimiter ;
+		framing.iov_len = 1 ;
+	}
+
+	this->_count += 2 ;
+	this->_pending += len + framing.iov_len ;
+	return true ;
+}
+
+size_t posicxx::FrameWriter::flush(int sockfd, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const size_t sent = this->flush(sockfd, flags, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return sent ;
+}
+
+size_t posicxx::FrameWriter::flush(int sockfd, int flags, std::error_code& ec) noexcept
+{
+	ec = std::error_code() ;
+	size_t total = 0 ;
+
+	while(this->_first < this->_count)
+	{
+		struct msghdr msg ;
+		std::memset(&msg, 0, sizeof(msg)) ;
+		msg.msg_iov = this->_iov + this->_first ;
+		msg.msg_iovlen = this->_count - this->_first ;
+
+		const ssize_t sent = posicxx::sendmsg(sockfd, &msg, flags, ec) ;
+		if(ec == std::errc::interrupted)
+		{
+			continue ;
+		}
+		if(ec)
+		{
+			return total ;
+		}
+
+		/* steps over fully sent iovecs & trims a partly sent one, so a short write resumes where it stopped */
+		size_t left = static_cast<size_t>(sent) ;
+		total += left ;
+		this->_pending -= left ;
+		while(this->_first < this->_count && left >= this->_iov[this->_first].iov_len)
+		{
+			left -= this->_iov[this->_first].iov_len ;
+			++this->_first ;
+		}
+		if(left > 0)
+		{
+			this->_iov[this->_first].iov_base = static_cast<char*>(this->_iov[this->_first].iov_base) + left ;
+			this->_iov[this->_first].iov_len -= left ;
+		}
+	}
+
+	this->_first = 0 ;
+	this->_count = 0 ;
+	return total ;
+}
+
+size_t posicxx::FrameWriter::pending() const noexcept
+{
+	return this->_pending ;
+}
+
+#ifdef SO_BUSY_POLL
+
+void posicxx::set_busy_poll(int sockfd, unsigned usec, bool prefer, unsigned budget) noexcept(false)
+{
+	const int value = static_cast<int>(usec) ;
+	posicxx::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value)) ;
+
+#ifdef SO_PREFER_BUSY_POLL
+	if(prefer)
+	{
+		const int preferred = 1 ;
+		posicxx::setsockopt(sockfd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &preferred, sizeof(preferred)) ;
+	}
+#else
+	static_cast<void>(prefer) ;
+#endif // #ifdef SO_PREFER_BUSY_POLL
+
+#ifdef SO_BUSY_POLL_BUDGET
+	if(budget != 0)
+	{
+		const int packets = static_cast<int>(budget) ;
+		posicxx::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &packets, sizeof(packets)) ;
+	}
+#else
+	static_cast<void>(budget) ;
+#endif // #ifdef SO_BUSY_POLL_BUDGET
+}
+
+#endif // #ifdef SO_BUSY_POLL
+
+ssize_t posicxx::spin_recv(int sockfd, void* buf, size_t len, int flags, unsigned long spins) noexcept(false)
+{
+	std::error_code ec ;
+	const ssize_t received = posicxx::spin_recv(sockfd, buf, len, flags, spins, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return received ;
+}
+
+ssize_t posicxx::spin_recv(int sockfd, void* buf, size_t len, int flags, unsigned long spins, std::error_code& ec) noexcept
+{
+	for(unsigned long attempt = 0 ; spins == 0 || attempt < spins ; ++attempt)
+	{
+		const ssize_t received = posicxx::recv(sockfd, buf, len, flags | MSG_DONTWAIT, ec) ;
+		if(!ec)
+		{
+			return received ;
+		}
+		if(ec != std::errc::resource_unavailable_try_again && ec != std::errc::operation_would_block && ec != std::errc::interrupted)
+		{
+			return -1 ;
+		}
+	}
+
+	ec = std::make_error_code(std::errc::resource_unavailable_try_again) ;
+	return -1 ;
+}
+
+#ifdef __linux__
+
+namespace {
+
+	constexpr unsigned fd_batch = 8 ; // messages per sendmmsg / recvmmsg call
+
+	struct FdMessages {
+		struct mmsghdr headers[fd_batch] ;
+		struct iovec iovecs[fd_batch] ;
+		char bytes[fd_batch] ;
+		alignas(struct cmsghdr) unsigned char controls[fd_batch][CMSG_SPACE(sizeof(int) * posicxx::scm_max_fd)] ;
+
+		/* points message i at its placeholder byte & at control room for `fds` descriptors */
+		struct msghdr& arm(unsigned i, size_t fds) noexcept
+		{
+			this->bytes[i] = 0 ;
+			this->iovecs[i].iov_base = &this->bytes[i] ;
+			this->iovecs[i].iov_len = 1 ;
+
+			struct msghdr& hdr = this->headers[i].msg_hdr ;
+			std::memset(&hdr, 0, sizeof(hdr)) ;
+			hdr.msg_iov = &this->iovecs[i] ;
+			hdr.msg_iovlen = 1 ;
+			hdr.msg_control = this->controls[i] ;
+			hdr.msg_controllen = CMSG_SPACE(sizeof(int) * fds) ;
+			this->headers[i].msg_len = 0 ;
+			return hdr ;
+		}
+	} ;
+
+}
+
+size_t posicxx::send_fds(int sockfd, const int* fds, size_t count, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const size_t sent = posicxx::send_fds(sockfd, fds, count, flags, ec) ;
+	if(ec)
+	{
+		throw std::system_error(ec) ;
+	}
+	return sent ;
+}
+
+size_t posicxx::send_fds(int sockfd, const int* fds, size_t count, int flags, std::error_code& ec) noexcept
+{
+	ec = std::error_code() ;
+	size_t sent = 0 ;
+	FdMessages messages ;
+
+	while(sent < count)
+	{
+		unsigned n = 0 ;
+		for(size_t at = sent ; at < count && n < fd_batch ; ++n)
+		{
+			const size_t chunk = std::min(posicxx::scm_max_fd, count - at) ;
+			struct msghdr& hdr = messages.arm(n, chunk) ;
+
+			struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr) ;
+			cmsg->cmsg_level = SOL_SOCKET ;
+			cmsg->cmsg_type = SCM_RIGHTS ;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(int) * chunk) ;
+			std::memcpy(CMSG_DATA(cmsg), fds + at, sizeof(int) * chunk) ;
+			at += chunk ;
+		}
+
+		const int done = ::sendmmsg(sockfd, messages.headers, n, flags) ;
+		if(done <= 0)
+		{
+			/* like sendmmsg itself, an error after some progress is left for the next call to report */
+			if(sent == 0)
+			{
+				ec = std::error_code(errno, std::generic_category()) ;
+			}
+			break ;
+		}
+		for(int i = 0 ; i < done ; ++i)
+		{
+			sent += std::min(posicxx::scm_max_fd, count - sent) ;
+		}
+	}
+
+	return sent ;
+}
+
+size_t posicxx::recv_fds(int sockfd, int* fds, size_t count, int flags) noexcept(false)
+{
+	std::error_code ec ;
+	const size_t received = posicxx::recv_fds(sockfd, fds, count, flags, ec) ;
+	if(ec)
+	{
+		for(size_t i = 0 ; i < received ; ++i)
+		{
+			::close(fds[i]) ; // not handed back, as the exception carries no count
+		}
+		throw std::system_error(ec) ;
+	}
+	return received ;
+}
+
+size_t posicxx::recv_fds(int sockfd, int* fds, size_t count, int flags, std::error_code& ec) noexcept
+{
+	ec = std::error_code() ;
+	if(count == 0)
+	{
+		return 0 ;
+	}
+
+	/* every message gets room for the most a sender can attach, so the kernel never truncates; only as many messages as count can hold are taken (at least one) */
+	FdMessages messages ;
+	const unsigned n = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(fd_batch, count / posicxx::scm_max_fd))) ;
+	for(unsigned i = 0 ; i < n ; ++i)
+	{
+		messages.arm(i, posicxx::scm_max_fd) ;
+	}
+
+	const int got = ::recvmmsg(sockfd, messages.headers, n, flags | MSG_CMSG_CLOEXEC | MSG_WAITFORONE, nullptr) ;
+	if(got < 0)
+	{
+		ec = std::error_code(errno, std::generic_category()) ;
+		return 0 ;
+	}
+
+	size_t received = 0 ;
+	bool lost = false ;
+	for(int i = 0 ; i < got && messages.headers[i].msg_len > 0 ; ++i)
+	{
+		struct msghdr& hdr = messages.headers[i].msg_hdr ;
+		lost = lost || (hdr.msg_flags & MSG_CTRUNC) != 0 ;
+		for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr) ; cmsg != nullptr ; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+		{
+			if(cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+			{
+				continue ;
+			}
+			const size_t k = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int) ;
+			const unsigned char* data = CMSG_DATA(cmsg) ;
+			for(size_t j = 0 ; j < k ; ++j)
+			{
+				int fd ;
+				std::memcpy(&fd, data + sizeof(int) * j, sizeof(int)) ;
+				if(received < count)
+				{
+					fds[received++] = fd ;
+				}
+				else
+				{
+					::close(fd) ; // no room left at fds
+					lost = true ;
+				}
+			}
+		}
+	}
+
+	if(lost)
+	{
+		ec = std::error_code(EMSGSIZE, std::generic_category()) ;
+	}
+	return received ;
+}
+
+#endif // #ifdef __linux__
+
+#if defined(__linux__) && defined(SO_TIMESTAMPING)
+
+int64_t posicxx::Timestamp::delay_ns() const noexcept
+{
+	return (static_cast<int64_t>(this->extracted.tv_sec) - this->kernel.tv_sec) * 1000000000 + (this->extracted.tv_nsec - this->kernel.tv_nsec) ;
+}
+
+int64_t posicxx::Timestamp::since_ns(const struct timespec& sent) const noexcept
+{
+	return (static_cast<int64_t>(this->kernel.tv_sec) - sent.tv_sec) * 1000000000 + (this->kernel.tv_nsec - sent.tv_nsec) ;
+}
+
+void posicxx::set_timestamping(int sockfd, unsigned flags) noexcept(false)
+{
+	posicxx::setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) ;
+}
+
+bool posicxx::rx_timestamp(const struct msghdr* msg, Timestamp* stamp) noexcept
+{
+	struct msghdr* const hdr = const_cast<struct msghdr*>(msg) ; // CMSG_NXTHDR only reads through it
+	for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(hdr) ; cmsg != nullptr ; cmsg = CMSG_NXTHDR(hdr, cmsg))
+	{
+		if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING)
+		{
+			struct scm_timestamping tss ;
+			std::memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss)) ;
+
+			stamp->id = 0 ;
+			stamp->type = -1 ;
+			stamp->kernel = tss.ts[0] ; // software stamp; [2] is the raw hardware one
+			::clock_gettime(CLOCK_REALTIME, &stamp->extracted) ;
+			return true ;
+		}
+	}
+	return false ;
+}
+
+size_t posicxx::tx_timestamps(int sockfd, Timestamp* stamps, size_t count) noexcept(false)
+{
+	size_t stashed = 0 ;
+
+	while(stashed < count)
+	{
+		alignas(struct cmsghdr) char control[errqueue_control] ;
+		struct msghdr msg ;
+		std::memset(&msg, 0, sizeof(msg)) ;
+		msg.msg_control = control ;
+		msg.msg_controllen = sizeof(control) ;
+
+		std::error_code ec ;
+		posicxx::recvmsg(sockfd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT, ec) ;
+		if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+		{
+			break ;
+		}
+		if(ec)
+		{
+			throw std::system_error(ec) ;
+		}
+
+		if(tx_stamp(&msg, &stamps[stashed]))
+		{
+			++stashed ;
+		}
+	}
+
+	return stashed ;
+}
+
+#endif // #if defined(__linux__) && defined(SO_TIMESTAMPING)
@@ -0,0 +1,286 @@
+#include "posixver.hh" // MUST BE INCLUDED FIRST in SRC files
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <system_error>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "sys/un.hh"
+
+/**
+ * @brief sys/un.cc - file serves as CXX definitions of POSIX Unix domain socket functionality, containing the minimal wrapper & fancy interface
+ */
+
+socklen_t posicxx::unix_address(const char* name, struct sockaddr_un* addr) noexcept(false)
+{
+	const size_t len = std::strlen(name) ;
+	if(len == 0)
+	{
+		throw std::system_error(EINVAL, std::generic_category()) ;
+	}
+
+	std::memset(addr, 0, sizeof(*addr)) ;
+	addr->sun_family = AF_UNIX ;
+#ifdef __linux__
+	if(name[0] == '@')
+	{
+		/* abstract names start with a NUL & are exactly as long as the address says, without a terminator */
+		if(len > sizeof(addr->sun_path))
+		{
+			throw std::system_error(ENAMETOOLONG, std::generic_category()) ;
+		}
+		std::memcpy(addr->sun_path + 1, name + 1, len - 1) ;
+		return static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + len) ;
+	}
+#endif // #ifdef __linux__
+	if(len >= sizeof(addr->sun_path))
+	{
+		throw std::system_error(ENAMETOOLONG, std::generic_category()) ;
+	}
+	std::memcpy(addr->sun_path, name, len) ;
+	return static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + len + 1) ;
+}
+
+#if defined(__linux__) && defined(SO_PEERCRED)
+
+namespace {
+
+	bool same_user(const struct ucred& peer) noexcept
+	{
+		return peer.uid == ::geteuid() ;
+	}
+
+}
+
+posicxx::BusListener::BusListener(const char* name, Authorize authorize, int backlog) noexcept(false) : _fd(-1), _path(), _authorize(authorize ? std::move(authorize) : Authorize(same_user)), _rejected(0)
+{
+	struct sockaddr_un addr ;
+	const socklen_t addrlen = posicxx::unix_address(name, &addr) ;
+
+	this->_fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0) ;
+	if(this->_fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	if(::bind(this->_fd, reinterpret_cast<struct sockaddr*>(&addr), addrlen) != 0 || ::listen(this->_fd, backlog) != 0)
+	{
+		const int error = errno ;
+		::close(this->_fd) ;
+		throw std::system_error(error, std::generic_category()) ;
+	}
+	if(name[0] != '@')
+	{
+		this->_path = name ;
+	}
+}
+
+int posicxx::BusListener::fd() const noexcept
+{
+	return this->_fd ;
+}
+
+int posicxx::BusListener::accept(struct ucred* peer) noexcept(false)
+{
+	for(;;)
+	{
+		std::error_code ec ;
+		const int fd = posicxx::accept4(this->_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC, ec) ;
+		if(fd < 0)
+		{
+			if(ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+			{
+				return -1 ;
+			}
+			if(ec == std::errc::interrupted || ec == std::errc::connection_aborted)
+			{
+				continue ;
+			}
+			throw std::system_error(ec) ;
+		}
+
+		struct ucred credentials ;
+		try
+		{
+			credentials = posicxx::getsockopt<sockopt::peercred>(fd) ;
+			if(!this->_authorize(credentials))
+			{
+				::close(fd) ;
+				++this->_rejected ;
+				continue ;
+			}
+		}
+		catch(...)
+		{
+			::close(fd) ;
+			throw ;
+		}
+
+		if(peer != nullptr)
+		{
+			*peer = credentials ;
+		}
+		return fd ;
+	}
+}
+
+size_t posicxx::BusListener::rejected() const noexcept
+{
+	return this->_rejected ;
+}
+
+posicxx::BusListener::~BusListener() noexcept
+{
+	::close(this->_fd) ;
+	if(!this->_path.empty())
+	{
+		::unlink(this->_path.c_str()) ;
+	}
+}
+
+posicxx::BusChannel::BusChannel(int fd) noexcept : _fd(fd)
+{
+}
+
+posicxx::BusChannel posicxx::BusChannel::connect(const char* name, BusListener::Authorize authorize) noexcept(false)
+{
+	struct sockaddr_un addr ;
+	const socklen_t addrlen = posicxx::unix_address(name, &addr) ;
+
+	/* connected while blocking, so a full backlog waits instead of failing with EAGAIN */
+	BusChannel channel(::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)) ;
+	if(channel._fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+	int result ;
+	do
+	{
+		result = ::connect(channel._fd, reinterpret_cast<struct sockaddr*>(&addr), addrlen) ;
+	}
+	while(result != 0 && errno == EINTR) ;
+	if(result != 0 || ::fcntl(channel._fd, F_SETFL, ::fcntl(channel._fd, F_GETFL) | O_NONBLOCK) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	const struct ucred listener = channel.peer() ;
+	if(!(authorize ? authorize(listener) : same_user(listener)))
+	{
+		throw std::system_error(EACCES, std::generic_category()) ;
+	}
+	return channel ;
+}
+
+int posicxx::BusChannel::fd() const noexcept
+{
+	return this->_fd ;
+}
+
+struct ucred posicxx::BusChannel::peer() const noexcept(false)
+{
+	return posicxx::getsockopt<sockopt::peercred>(this->_fd) ;
+}
+
+bool posicxx::BusChannel::send(const void* data, size_t len, std::error_code& ec) noexcept
+{
+	if(len == 0)
+	{
+		ec.assign(EINVAL, std::generic_category()) ;
+		return false ;
+	}
+	return posicxx::send(this->_fd, data, len, MSG_NOSIGNAL, ec) >= 0 ;
+}
+
+size_t posicxx::BusChannel::send(const struct iovec* messages, size_t count, std::error_code& ec) noexcept
+{
+	constexpr size_t batch = 64 ;
+	struct mmsghdr headers[batch] ;
+	size_t sent = 0 ;
+	ec.clear() ;
+
+	while(sent < count)
+	{
+		size_t n = 0 ;
+		while(n < batch && sent + n < count && messages[sent + n].iov_len != 0)
+		{
+			std::memset(&headers[n], 0, sizeof(headers[n])) ;
+			headers[n].msg_hdr.msg_iov = const_cast<struct iovec*>(&messages[sent + n]) ; // sendmmsg doesn't write through msg_iov
+			headers[n].msg_hdr.msg_iovlen = 1 ;
+			++n ;
+		}
+		if(n == 0)
+		{
+			ec.assign(EINVAL, std::generic_category()) ; // zero-length message, reached after sending those before it
+			return sent ;
+		}
+
+		const int done = posicxx::sendmmsg(this->_fd, headers, static_cast<unsigned>(n), MSG_NOSIGNAL, ec) ;
+		if(done < 0)
+		{
+			return sent ;
+		}
+		sent += static_cast<size_t>(done) ;
+		if(static_cast<size_t>(done) < n)
+		{
+			/* the socket filled up part-way; sendmmsg only reports an error for its first message */
+			ec.assign(EAGAIN, std::generic_category()) ;
+			return sent ;
+		}
+	}
+	return sent ;
+}
+
+size_t posicxx::BusChannel::recv(void* buf, size_t len, std::error_code& ec) noexcept
+{
+	struct iovec iov ;
+	iov.iov_base = buf ;
+	iov.iov_len = len ;
+	struct msghdr msg ;
+	std::memset(&msg, 0, sizeof(msg)) ;
+	msg.msg_iov = &iov ;
+	msg.msg_iovlen = 1 ;
+
+	const ssize_t received = posicxx::recvmsg(this->_fd, &msg, 0, ec) ;
+	if(received < 0)
+	{
+		return 0 ;
+	}
+	if(msg.msg_flags & MSG_TRUNC)
+	{
+		ec.assign(EMSGSIZE, std::generic_category()) ;
+		return 0 ;
+	}
+	return static_cast<size_t>(received) ;
+}
+
+posicxx::BusChannel::BusChannel(BusChannel&& channel) noexcept : _fd(channel._fd)
+{
+	channel._fd = -1 ;
+}
+
+posicxx::BusChannel& posicxx::BusChannel::operator=(BusChannel&& channel) noexcept
+{
+	if(this != &channel)
+	{
+		if(this->_fd >= 0)
+		{
+			::close(this->_fd) ;
+		}
+		this->_fd = channel._fd ;
+		channel._fd = -1 ;
+	}
+	return *this ;
+}
+
+posicxx::BusChannel::~BusChannel() noexcept
+{
+	if(this->_fd >= 0)
+	{
+		::close(this->_fd) ;
+	}
+}
+
+#endif // #if defined(__linux__) && defined(SO_PEERCRED)
@@ -3,6 +3,8 @@
 #include <system_error>
 #include <cstdarg>
 #include <memory>
+#include <cstring>
+#include <new>
 
 #include "unistd.hh"
 
@@ -105,6 +107,22 @@ int posicxx::dup2(int fildes, int fildes2) noexcept(false)
 	return fd ;
 }
 
+#ifdef __linux__
+
+int posicxx::dup3(int fildes, int fildes2, int flags) noexcept(false)
+{
+	int fd = ::dup3(fildes, fildes2, flags) ;
+
+	if(fd < 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+
+	return fd ;
+}
+
+#endif // #ifdef __linux__
+
 void posicxx::execl(const char* path, const char* arg0, ...) noexcept(false)
 {
 	/* we want to count the number of arguments */
@@ -296,6 +314,20 @@ void posicxx::getcwd(char* buf, size_t size) noexcept(false)
 	}
 }
 
+void posicxx::getcwd(StringBuffer& buf) noexcept(false)
+{
+	while(::getcwd(buf.data(), buf.capacity()) == NULL)
+	{
+		if(errno != ERANGE)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+		buf.reserve(buf.capacity() * 2) ;
+	}
+
+	buf.resize(std::strlen(buf.data())) ;
+}
+
 gid_t posicxx::getegid() noexcept
 {
 	return ::getegid() ;
@@ -336,6 +368,28 @@ void posicxx::gethostname(char* name, size_t namelen) noexcept(false)
 	}
 }
 
+void posicxx::gethostname(StringBuffer& name) noexcept(false)
+{
+	while(true)
+	{
+		if(::gethostname(name.data(), name.capacity()) != 0)
+		{
+			/* glibc reports truncation as ENAMETOOLONG, other implementations as EINVAL */
+			if(errno != ENAMETOOLONG && errno != EINVAL)
+			{
+				throw std::system_error(errno, std::generic_category()) ;
+			}
+		}
+		else if(std::memchr(name.data(), '\0', name.capacity()) != NULL) // POSIX leaves silently truncated names unterminated
+		{
+			break ;
+		}
+		name.reserve(name.capacity() * 2) ;
+	}
+
+	name.resize(std::strlen(name.data())) ;
+}
+
 char* posicxx::getlogin() noexcept(false)
 {
 	char* loginn = ::getlogin() ;
@@ -356,6 +410,21 @@ void posicxx::getlogin_r(char* name, size_t namesize)noexcept(false)
 	}
 }
 
+void posicxx::getlogin_r(StringBuffer& name) noexcept(false)
+{
+	int rgetlogin ;
+	while((rgetlogin = ::getlogin_r(name.data(), name.capacity())) != 0)
+	{
+		if(rgetlogin != ERANGE)
+		{
+			throw std::system_error(rgetlogin, std::generic_category()) ;
+		}
+		name.reserve(name.capacity() * 2) ;
+	}
+
+	name.resize(std::strlen(name.data())) ;
+}
+
 int posicxx::getopt(int argc, char* const argv[], const char* optstring) noexcept
 {
 	return ::getopt(argc, argv, optstring) ;
@@ -413,6 +482,11 @@ void posicxx::getwd(char* path_name) noexcept(false)
 	}
 }
 
+void posicxx::getwd(StringBuffer& path_name) noexcept(false)
+{
+	posicxx::getcwd(path_name) ;
+}
+
 int posicxx::isatty(int fildes) noexcept(false)
 {
 	int result = ::isatty(fildes) ;
@@ -502,6 +576,18 @@ void posicxx::pipe(int fildes[2]) noexcept(false)
 	}
 }
 
+#ifdef __linux__
+
+void posicxx::pipe2(int fildes[2], int flags) noexcept(false)
+{
+	if(::pipe2(fildes, flags) != 0)
+	{
+		throw std::system_error(errno, std::generic_category()) ;
+	}
+}
+
+#endif // #ifdef __linux__
+
 ssize_t posicxx::pread(int fildes, void* buf, size_t nbyte, off_t offset) noexcept(false)
 {
 	ssize_t rread = ::pread(fildes, buf, nbyte, offset) ;
@@ -550,6 +636,27 @@ ssize_t posicxx::readlink(const char* path, char* buf, size_t bufsize) noexcept(
 	return rread ;
 }
 
+ssize_t posicxx::readlink(const char* path, StringBuffer& buf) noexcept(false)
+{
+	while(true)
+	{
+		const ssize_t rread = ::readlink(path, buf.data(), buf.capacity()) ;
+
+		if(rread < 0)
+		{
+			throw std::system_error(errno, std::generic_category()) ;
+		}
+
+		/* a link filling the whole buffer may have been truncated - there must be room left for the terminator anyway */
+		if(static_cast<size_t>(rread) < buf.capacity())
+		{
+			buf.resize(static_cast<size_t>(rread)) ;
+			return rread ;
+		}
+		buf.reserve(buf.capacity() * 2) ;
+	}
+}
+
 void posicxx::rmdir(const char* path) noexcept(false)
 {
 	if(::rmdir(path) != 0)
@@ -715,6 +822,21 @@ void posicxx::ttyname_r(int fildes, char* name, size_t namesize) noexcept(false)
 	}
 }
 
+void posicxx::ttyname_r(int fildes, StringBuffer& name) noexcept(false)
+{
+	int rttyname ;
+	while((rttyname = ::ttyname_r(fildes, name.data(), name.capacity())) != 0)
+	{
+		if(rttyname != ERANGE)
+		{
+			throw std::system_error(rttyname, std::generic_category()) ;
+		}
+		name.reserve(name.capacity() * 2) ;
+	}
+
+	name.resize(std::strlen(name.data())) ;
+}
+
 useconds_t posicxx::ualarm(useconds_t useconds, useconds_t interval) noexcept
 {
 	return ::ualarm(useconds, interval) ;
@@ -759,3 +881,119 @@ ssize_t posicxx::write(int fildes, const void* buf, size_t nbyte) noexcept(false
 
 	return rwrite ;
 }
+
+posicxx::StringBuffer::StringBuffer(char* storage, size_t capacity) noexcept : _data(storage), _size(0), _capacity(capacity), _inline(storage), _inline_capacity(capacity)
+{
+	this->_data[0] = '\0' ;
+}
+
+void posicxx::StringBuffer::_acquire(StringBuffer& other) noexcept(false)
+{
+	if(other.inlined())
+	{
+		this->assign(other._data, other._size) ;
+	}
+	else
+	{
+		if(!this->inlined())
+		{
+			delete[] this->_data ;
+		}
+		this->_data = other._data ;
+		this->_size = other._size ;
+		this->_capacity = other._capacity ;
+
+		other._data = other._inline ;
+		other._capacity = other._inline_capacity ;
+	}
+
+	other.clear() ;
+}
+
+char* posicxx::StringBuffer::data() noexcept
+{
+	return this->_data ;
+}
+
+const char* posicxx::StringBuffer::data() const noexcept
+{
+	return this->_data ;
+}
+
+const char* posicxx::StringBuffer::c_str() const noexcept
+{
+	return this->_data ;
+}
+
+size_t posicxx::StringBuffer::size() const noexcept
+{
+	return this->_size ;
+}
+
+size_t posicxx::StringBuffer::capacity() const noexcept
+{
+	return this->_capacity ;
+}
+
+bool posicxx::StringBuffer::empty() const noexcept
+{
+	return this->_size == 0 ;
+}
+
+bool posicxx::StringBuffer::inlined() const noexcept
+{
+	return this->_data == this->_inline ;
+}
+
+void posicxx::StringBuffer::reserve(size_t capacity) noexcept(false)
+{
+	if(capacity <= this->_capacity)
+	{
+		return ;
+	}
+
+	char* data = new(std::nothrow) char[capacity] ;
+	if(data == nullptr)
+	{
+		throw std::system_error(ENOMEM, std::generic_category()) ;
+	}
+	std::memcpy(data, this->_data, this->_size + 1) ;
+
+	if(!this->inlined())
+	{
+		delete[] this->_data ;
+	}
+	this->_data = data ;
+	this->_capacity = capacity ;
+}
+
+void posicxx::StringBuffer::resize(size_t size) noexcept
+{
+	this->_size = size ;
+	this->_data[size] = '\0' ;
+}
+
+void posicxx::StringBuffer::assign(const char* str, size_t len) noexcept(false)
+{
+	if(len >= this->_capacity)
+	{
+		this->_size = 0 ; // nothing worth preserving across the reallocation
+		this->reserve(len + 1) ;
+	}
+
+	std::memmove(this->_data, str, len) ;
+	this->resize(len) ;
+}
+
+void posicxx::StringBuffer::clear() noexcept
+{
+	this->resize(0) ;
+}
+
+posicxx::StringBuffer::~StringBuffer() noexcept
+{
+	if(!this->inlined())
+	{
+		delete[] this->_data ;
+	}
+}